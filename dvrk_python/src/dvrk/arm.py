@@ -68,6 +68,17 @@ implementing an incremental move, one should always use the last
 desired position.  If one needs to track the arm, it is better to
 use the current position.
 
+Native core
+===========
+
+If the compiled module `dvrk._arm_core` is available, the continuous
+topics (joint states, cartesian positions, twist, wrench and
+Jacobians) are received by roscpp in a native thread.  Only the
+latest message is kept and it is converted to numpy arrays or PyKDL
+frames when a getter is called, so callbacks don't compete with the
+user's code for the GIL.  Set the environment variable
+`DVRK_PYTHON_NATIVE` to `0` to use rospy subscribers instead.
+
 Arm API
 =========
 
@@ -76,6 +87,7 @@ Arm API
 # sphinx-apidoc -F -A "Yijun Hu" -o doc src
 
 from __future__ import print_function
+import os
 import inspect
 import threading
 import math
@@ -91,6 +103,15 @@ from std_msgs.msg import String, Bool, Float32, Empty, Float64MultiArray
 from geometry_msgs.msg import Pose, PoseStamped, Vector3, Quaternion, Wrench, WrenchStamped, TwistStamped
 from sensor_msgs.msg import JointState, Joy
 
+# native core for continuous topics, see dvrk_arm_core.cpp.  Set
+# DVRK_PYTHON_NATIVE to 0 to use rospy subscribers instead.
+try:
+    from dvrk import _arm_core
+except ImportError as error:
+    _arm_core = None
+    if os.environ.get('DVRK_PYTHON_NATIVE', '1') != '0':
+        print('Warning: dvrk._arm_core not available (', error, '), using rospy subscribers for continuous topics')
+
 # from code import InteractiveConsole
 # from imp import new_module
 
@@ -195,33 +216,49 @@ class arm(object):
                            self.__set_wrench_body_orientation_absolute_pub,
                            self.__set_wrench_spatial_pub,
                            self.__set_gravity_compensation_pub]
-        # subscribers
+        # subscribers for events
         self.__sub_list = [rospy.Subscriber(self.__full_ros_namespace + '/current_state',
                                             String, self.__arm_current_state_cb),
                            rospy.Subscriber(self.__full_ros_namespace + '/desired_state',
                                           String, self.__arm_desired_state_cb),
                            rospy.Subscriber(self.__full_ros_namespace + '/goal_reached',
-                                          Bool, self.__goal_reached_cb),
-                           rospy.Subscriber(self.__full_ros_namespace + '/state_joint_desired',
-                                          JointState, self.__state_joint_desired_cb),
-                           rospy.Subscriber(self.__full_ros_namespace + '/position_cartesian_desired',
-                                          PoseStamped, self.__position_cartesian_desired_cb),
-                           rospy.Subscriber(self.__full_ros_namespace + '/position_cartesian_local_desired',
-                                          PoseStamped, self.__position_cartesian_local_desired_cb),
-                           rospy.Subscriber(self.__full_ros_namespace + '/state_joint_current',
-                                          JointState, self.__state_joint_current_cb),
-                           rospy.Subscriber(self.__full_ros_namespace + '/position_cartesian_current',
-                                          PoseStamped, self.__position_cartesian_current_cb),
-                           rospy.Subscriber(self.__full_ros_namespace + '/position_cartesian_local_current',
-                                          PoseStamped, self.__position_cartesian_local_current_cb),
-                           rospy.Subscriber(self.__full_ros_namespace + '/twist_body_current',
-                                          TwistStamped, self.__twist_body_current_cb),
-                           rospy.Subscriber(self.__full_ros_namespace + '/wrench_body_current',
-                                          WrenchStamped, self.__wrench_body_current_cb),
-                           rospy.Subscriber(self.__full_ros_namespace + '/jacobian_spatial',
-                                          Float64MultiArray, self.__jacobian_spatial_cb),
-                           rospy.Subscriber(self.__full_ros_namespace + '/jacobian_body',
-                                          Float64MultiArray, self.__jacobian_body_cb)]
+                                          Bool, self.__goal_reached_cb)]
+
+        # continuous topics, use the native core if available
+        self.__core = None
+        if _arm_core and (os.environ.get('DVRK_PYTHON_NATIVE', '1') != '0'):
+            self.__core = _arm_core.arm_core(self.__full_ros_namespace)
+            for topic in ['/state_joint_desired', '/state_joint_current']:
+                self.__core.add_joint_state(topic)
+            for topic in ['/position_cartesian_desired', '/position_cartesian_local_desired',
+                          '/position_cartesian_current', '/position_cartesian_local_current']:
+                self.__core.add_pose(topic)
+            self.__core.add_twist('/twist_body_current')
+            self.__core.add_wrench('/wrench_body_current')
+            self.__core.add_matrix('/jacobian_spatial')
+            self.__core.add_matrix('/jacobian_body')
+        else:
+            self.__sub_list.extend([
+                rospy.Subscriber(self.__full_ros_namespace + '/state_joint_desired',
+                                 JointState, self.__state_joint_desired_cb),
+                rospy.Subscriber(self.__full_ros_namespace + '/position_cartesian_desired',
+                                 PoseStamped, self.__position_cartesian_desired_cb),
+                rospy.Subscriber(self.__full_ros_namespace + '/position_cartesian_local_desired',
+                                 PoseStamped, self.__position_cartesian_local_desired_cb),
+                rospy.Subscriber(self.__full_ros_namespace + '/state_joint_current',
+                                 JointState, self.__state_joint_current_cb),
+                rospy.Subscriber(self.__full_ros_namespace + '/position_cartesian_current',
+                                 PoseStamped, self.__position_cartesian_current_cb),
+                rospy.Subscriber(self.__full_ros_namespace + '/position_cartesian_local_current',
+                                 PoseStamped, self.__position_cartesian_local_current_cb),
+                rospy.Subscriber(self.__full_ros_namespace + '/twist_body_current',
+                                 TwistStamped, self.__twist_body_current_cb),
+                rospy.Subscriber(self.__full_ros_namespace + '/wrench_body_current',
+                                 WrenchStamped, self.__wrench_body_current_cb),
+                rospy.Subscriber(self.__full_ros_namespace + '/jacobian_spatial',
+                                 Float64MultiArray, self.__jacobian_spatial_cb),
+                rospy.Subscriber(self.__full_ros_namespace + '/jacobian_body',
+                                 Float64MultiArray, self.__jacobian_body_cb)])
 
         # create node
         if not rospy.get_node_uri():
@@ -342,6 +379,49 @@ class arm(object):
         jacobian.shape = data.layout.dim[0].size, data.layout.dim[1].size
         self.__jacobian_body = jacobian
 
+    def __core_joint_state(self, topic, field):
+        """Get a field (0: position, 1: velocity, 2: effort) of a joint
+        state received by the native core.
+
+        :returns: the field
+        :rtype: `numpy.ndarray <https://docs.scipy.org/doc/numpy/reference/generated/numpy.ndarray.html>`_"""
+        return numpy.array(self.__core.joint_state(topic)[field], dtype = numpy.float)
+
+
+    def __core_frame(self, topic):
+        """Get a pose received by the native core.
+
+        :returns: the pose, identity if no pose has been received yet
+        :rtype: `PyKDL.Frame <http://docs.ros.org/diamondback/api/kdl/html/python/geometric_primitives.html>`_"""
+        p = self.__core.vector(topic)
+        if (len(p) != 7):
+            return PyKDL.Frame()
+        return PyKDL.Frame(PyKDL.Rotation.Quaternion(p[3], p[4], p[5], p[6]),
+                           PyKDL.Vector(p[0], p[1], p[2]))
+
+
+    def __core_vector(self, topic):
+        """Get a twist or wrench received by the native core.
+
+        :returns: linear and angular values
+        :rtype: `numpy.ndarray <https://docs.scipy.org/doc/numpy/reference/generated/numpy.ndarray.html>`_"""
+        v = self.__core.vector(topic)
+        if (len(v) != 6):
+            return numpy.zeros(6, dtype = numpy.float)
+        return numpy.array(v, dtype = numpy.float)
+
+
+    def __core_matrix(self, topic):
+        """Get a matrix (Jacobian) received by the native core.
+
+        :returns: the matrix
+        :rtype: `numpy.ndarray <https://docs.scipy.org/doc/numpy/reference/generated/numpy.ndarray.html>`_"""
+        rows, cols, data = self.__core.matrix(topic)
+        matrix = numpy.array(data, dtype = numpy.float)
+        matrix.shape = rows, cols
+        return matrix
+
+
     def __set_desired_state(self, state, timeout = 5):
         """Set state with block.
 
@@ -409,6 +489,8 @@ class arm(object):
 
         :returns: the current position of the arm in cartesian space
         :rtype: `PyKDL.Frame <http://docs.ros.org/diamondback/api/kdl/html/python/geometric_primitives.html>`_"""
+        if self.__core:
+            return self.__core_frame('/position_cartesian_current')
         return self.__position_cartesian_current
 
 
@@ -417,6 +499,8 @@ class arm(object):
 
         :returns: the current position of the arm in cartesian space
         :rtype: `PyKDL.Frame <http://docs.ros.org/diamondback/api/kdl/html/python/geometric_primitives.html>`_"""
+        if self.__core:
+            return self.__core_frame('/position_cartesian_local_current')
         return self.__position_cartesian_local_current
 
 
@@ -427,6 +511,8 @@ class arm(object):
 
         :returns: the current position of the arm in cartesian space
         :rtype: geometry_msgs.TwistStamped"""
+        if self.__core:
+            return self.__core_vector('/twist_body_current')
         return self.__twist_body_current
 
 
@@ -439,6 +525,8 @@ class arm(object):
 
         :returns: the current force applied to the arm in cartesian space
         :rtype: geometry_msgs.WrenchStamped"""
+        if self.__core:
+            return self.__core_vector('/wrench_body_current')
         return self.__wrench_body_current
 
 
@@ -448,6 +536,8 @@ class arm(object):
 
         :returns: the current position of the arm in joint space
         :rtype: `JointState <http://docs.ros.org/api/sensor_msgs/html/msg/JointState.html>`_"""
+        if self.__core:
+            return self.__core_joint_state('/state_joint_current', 0)
         return self.__position_joint_current
 
 
@@ -457,6 +547,8 @@ class arm(object):
 
         :returns: the current position of the arm in joint space
         :rtype: `JointState <http://docs.ros.org/api/sensor_msgs/html/msg/JointState.html>`_"""
+        if self.__core:
+            return self.__core_joint_state('/state_joint_current', 1)
         return self.__velocity_joint_current
 
 
@@ -466,6 +558,8 @@ class arm(object):
 
         :returns: the current position of the arm in joint space
         :rtype: `JointState <http://docs.ros.org/api/sensor_msgs/html/msg/JointState.html>`_"""
+        if self.__core:
+            return self.__core_joint_state('/state_joint_current', 2)
         return self.__effort_joint_current
 
     def get_jacobian_spatial(self):
@@ -473,6 +567,8 @@ class arm(object):
 
         :returns: the jacobian spatial of the arm
         :rtype: `numpy.ndarray <https://docs.scipy.org/doc/numpy/reference/generated/numpy.ndarray.html>`_"""
+        if self.__core:
+            return self.__core_matrix('/jacobian_spatial')
         return self.__jacobian_spatial
 
     def get_jacobian_body(self):
@@ -480,6 +576,8 @@ class arm(object):
 
         :returns: the jacobian body of the arm
         :rtype: `numpy.ndarray <https://docs.scipy.org/doc/numpy/reference/generated/numpy.ndarray.html>`_"""
+        if self.__core:
+            return self.__core_matrix('/jacobian_body')
         return self.__jacobian_body
 
     def get_desired_position(self):
@@ -487,6 +585,8 @@ class arm(object):
 
         :returns: the desired position of the arm in cartesian space
         :rtype: `PyKDL.Frame <http://docs.ros.org/diamondback/api/kdl/html/python/geometric_primitives.html>`_"""
+        if self.__core:
+            return self.__core_frame('/position_cartesian_desired')
         return self.__position_cartesian_desired
 
 
@@ -495,6 +595,8 @@ class arm(object):
 
         :returns: the desired position of the arm in cartesian space
         :rtype: `PyKDL.Frame <http://docs.ros.org/diamondback/api/kdl/html/python/geometric_primitives.html>`_"""
+        if self.__core:
+            return self.__core_frame('/position_cartesian_local_desired')
         return self.__position_cartesian_local_desired
 
 
@@ -504,6 +606,8 @@ class arm(object):
 
         :returns: the desired position of the arm in joint space
         :rtype: `JointState <http://docs.ros.org/api/sensor_msgs/html/msg/JointState.html>`_"""
+        if self.__core:
+            return self.__core_joint_state('/state_joint_desired', 0)
         return self.__position_joint_desired
 
 
@@ -513,6 +617,8 @@ class arm(object):
 
         :returns: the desired effort of the arm in joint space
         :rtype: `JointState <http://docs.ros.org/api/sensor_msgs/html/msg/JointState.html>`_"""
+        if self.__core:
+            return self.__core_joint_state('/state_joint_desired', 2)
         return self.__effort_joint_desired
 
 
@@ -521,7 +627,7 @@ class arm(object):
 
         :returns: the number of joints on the specified arm
         :rtype: int"""
-        joint_num = len(self.__position_joint_desired)
+        joint_num = len(self.get_desired_joint_position())
         return joint_num
 
 
@@ -595,7 +701,7 @@ class arm(object):
         :param delta_frame: the incremental `PyKDL.Frame <http://docs.ros.org/diamondback/api/kdl/html/python/geometric_primitives.html>`_ based upon the current position
         :param interpolate: see  :ref:`interpolate <interpolate>`"""
         # add the incremental move to the current position, to get the ending frame
-        end_frame = delta_frame * self.__position_cartesian_desired
+        end_frame = delta_frame * self.get_desired_position()
         return self.__move_frame(end_frame, interpolate, blocking)
 
 
@@ -620,7 +726,7 @@ class arm(object):
         :param abs_translation: the absolute translation you want to make based on the current position, this is in terms of a  `PyKDL.Vector <http://docs.ros.org/diamondback/api/kdl/html/python/geometric_primitives.html>`_
         :param interpolate: see  :ref:`interpolate <interpolate>`"""
         # convert into a Frame
-        abs_rotation = self.__position_cartesian_desired.M
+        abs_rotation = self.get_desired_position().M
         abs_frame = PyKDL.Frame(abs_rotation, abs_translation)
         return self.__move_frame(abs_frame, interpolate, blocking)
 
@@ -631,7 +737,7 @@ class arm(object):
         :param abs_rotation: the absolute `PyKDL.Rotation <http://docs.ros.org/diamondback/api/kdl/html/python/geometric_primitives.html>`_
         :param interpolate: see  :ref:`interpolate <interpolate>`"""
         # convert into a Frame
-        abs_vector = self.__position_cartesian_desired.p
+        abs_vector = self.get_desired_position().p
         abs_frame = PyKDL.Frame(abs_rotation, abs_vector)
         return self.__move_frame(abs_frame, interpolate, blocking)
 
@@ -707,7 +813,7 @@ class arm(object):
             print("delta_pos must be an array of size", self.get_joint_number())
             return False
 
-        abs_pos = numpy.array(self.__position_joint_desired)
+        abs_pos = numpy.array(self.get_desired_joint_position())
         abs_pos = abs_pos+ delta_pos
         return self.__move_joint(abs_pos, interpolate, blocking)
 
@@ -753,7 +859,7 @@ class arm(object):
                 print("all indices must be less than", self.get_joint_number())
                 return False
 
-        abs_pos = numpy.array(self.__position_joint_desired)
+        abs_pos = numpy.array(self.get_desired_joint_position())
         for i in range(len(indices)):
             abs_pos[indices[i]] = abs_pos[indices[i]] + delta_pos[i]
 
@@ -818,7 +924,7 @@ class arm(object):
                 print("all indices must be less than", self.get_joint_number())
                 return False
 
-        abs_pos_result = numpy.array(self.__position_joint_desired)
+        abs_pos_result = numpy.array(self.get_desired_joint_position())
         for i in range(len(indices)):
             abs_pos_result[indices[i]] = abs_pos[i]
 
@@ -879,6 +985,68 @@ class arm(object):
         return True
 
 
+    def stream_joint_positions(self, setpoints, rate, queue_size = 100, priority = 0):
+        """Publish joint setpoints at a fixed rate, bypassing the
+        trajectory generator.  Setpoints are published by a native
+        thread (see `dvrk._arm_core`) so the timing doesn't depend on
+        the Python interpreter.
+
+        :param setpoints: list, array or generator of joint positions
+        :param rate: rate in Hz
+        :param queue_size: maximum number of setpoints queued ahead of the native thread
+        :param priority: SCHED_FIFO priority of the native thread, 0 to use the default scheduler
+        :returns: timing statistics, see `stream_positions`
+        :rtype: dict"""
+        return self.__stream('joint', (numpy.asarray(p, dtype = numpy.float).tolist() for p in setpoints),
+                             rate, queue_size, priority)
+
+
+    def stream_positions(self, frames, rate, queue_size = 100, priority = 0):
+        """Publish cartesian setpoints at a fixed rate, bypassing the
+        trajectory generator.  Frames can be a list or a generator,
+        e.g. computed on the fly while the native thread publishes the
+        previous ones.
+
+        :param frames: list or generator of `PyKDL.Frame <http://docs.ros.org/diamondback/api/kdl/html/python/geometric_primitives.html>`_
+        :param rate: rate in Hz
+        :param queue_size: maximum number of setpoints queued ahead of the native thread
+        :param priority: SCHED_FIFO priority of the native thread, 0 to use the default scheduler
+        :returns: timing statistics: `periods`, `published`,
+                  `missed` (periods skipped because the thread woke
+                  up too late), `underruns` (periods without setpoint
+                  because the generator was too slow) and two
+                  dictionaries (`count`, `min`, `max`, `mean`, `std`
+                  in seconds), `jitter` for the wake up lateness and
+                  `delay` between publishing a setpoint and receiving
+                  it back on the arm's desired state.
+        :rtype: dict"""
+        return self.__stream('cartesian', ((f.p[0], f.p[1], f.p[2]) + f.M.GetQuaternion() for f in frames),
+                             rate, queue_size, priority)
+
+
+    def __stream(self, space, setpoints, rate, queue_size, priority):
+        """Push setpoints to a native servo_stream and wait until all
+        have been published.
+
+        :returns: timing statistics
+        :rtype: dict"""
+        if not _arm_core:
+            raise RuntimeError('streaming requires the native core dvrk._arm_core, see README')
+        stream = _arm_core.servo_stream(self.__full_ros_namespace, space,
+                                        rate, queue_size, priority)
+        if not stream.start(1.0):
+            raise RuntimeError('no subscriber for ' + self.__full_ros_namespace + ' setpoints, is the console running?')
+        try:
+            for setpoint in setpoints:
+                stream.push(setpoint)
+            # at most queue_size setpoints left
+            if not stream.drain(queue_size / float(rate) + 1.0):
+                print('timeout while streaming setpoints, not all setpoints have been published')
+        finally:
+            stream.stop()
+        return stream.statistics()
+
+
     def set_effort_joint(self, effort):
         if ((not(type(effort) is numpy.ndarray))
             or (not(effort.dtype == numpy.float64))):
@@ -35,8 +35,11 @@ class mtm(arm):
         self._arm__pub_list.extend([self.__lock_orientation_pub,
                                self.__unlock_orientation_pub])
         # subscribers
-        self._arm__sub_list.extend([rospy.Subscriber(self._arm__full_ros_namespace + '/state_gripper_current',
-                         JointState, self.__state_gripper_current_cb)])
+        if self._arm__core:
+            self._arm__core.add_joint_state('/state_gripper_current')
+        else:
+            self._arm__sub_list.extend([rospy.Subscriber(self._arm__full_ros_namespace + '/state_gripper_current',
+                             JointState, self.__state_gripper_current_cb)])
 
 
     def __state_gripper_current_cb(self, data):
@@ -44,6 +47,10 @@ class mtm(arm):
 
     def get_current_gripper_position(self):
         "get the current angle of the gripper"
+        if self._arm__core:
+            position = self._arm__core_joint_state('/state_gripper_current', 0)
+            if len(position) > 0:
+                return position[0]
         return self.__position_gripper_current
 
     def lock_orientation_as_is(self):
@@ -47,11 +47,15 @@ class psm(arm):
                                     self.__set_effort_jaw_pub,
                                     self.__set_tool_present_pub])
         # subscribers
-        self._arm__sub_list.extend([
-        rospy.Subscriber(self._arm__full_ros_namespace + '/state_jaw_desired',
-                         JointState, self.__state_jaw_desired_cb),
-        rospy.Subscriber(self._arm__full_ros_namespace + '/state_jaw_current',
-                         JointState, self.__state_jaw_current_cb)])
+        if self._arm__core:
+            self._arm__core.add_joint_state('/state_jaw_desired')
+            self._arm__core.add_joint_state('/state_jaw_current')
+        else:
+            self._arm__sub_list.extend([
+            rospy.Subscriber(self._arm__full_ros_namespace + '/state_jaw_desired',
+                             JointState, self.__state_jaw_desired_cb),
+            rospy.Subscriber(self._arm__full_ros_namespace + '/state_jaw_current',
+                             JointState, self.__state_jaw_current_cb)])
 
 
     def __state_jaw_desired_cb(self, data):
@@ -67,25 +71,42 @@ class psm(arm):
             self.__effort_jaw_current = data.effort[0]
 
 
+    def __core_jaw(self, topic, field, default):
+        "get the jaw value from the native core, default if not available"
+        values = self._arm__core_joint_state(topic, field)
+        if len(values) == 1:
+            return values[0]
+        return default
+
     def get_current_jaw_position(self):
         "get the current angle of the jaw"
+        if self._arm__core:
+            return self.__core_jaw('/state_jaw_current', 0, self.__position_jaw_current)
         return self.__position_jaw_current
 
     def get_current_jaw_velocity(self):
         "get the current angular velocity of the jaw"
+        if self._arm__core:
+            return self.__core_jaw('/state_jaw_current', 1, self.__velocity_jaw_current)
         return self.__velocity_jaw_current
 
     def get_current_jaw_effort(self):
         "get the current torque applied to the jaw"
+        if self._arm__core:
+            return self.__core_jaw('/state_jaw_current', 2, self.__effort_jaw_current)
         return self.__effort_jaw_current
 
 
     def get_desired_jaw_position(self):
         "get the desired angle of the jaw"
+        if self._arm__core:
+            return self.__core_jaw('/state_jaw_desired', 0, self.__position_jaw_desired)
         return self.__position_jaw_desired
 
     def get_desired_jaw_effort(self):
         "get the desired torque to be applied to the jaw"
+        if self._arm__core:
+            return self.__core_jaw('/state_jaw_desired', 2, self.__effort_jaw_desired)
         return self.__effort_jaw_desired
 
 
@@ -0,0 +1,730 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-27
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// Native core for the Python dvrk.arm class (module dvrk._arm_core).
+// Continuous topics (joint states, cartesian positions...) are
+// received by roscpp in a separate spinner thread, without the GIL,
+// and only the latest message is kept in native buffers.  Data is
+// converted to Python objects only when a getter is called.  The
+// module also provides servo_stream, a native thread publishing
+// setpoints at a fixed rate.
+
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <cmath>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <limits>
+
+#include <boost/python.hpp>
+
+#include <ros/ros.h>
+#include <ros/callback_queue.h>
+#include <sensor_msgs/JointState.h>
+#include <geometry_msgs/Pose.h>
+#include <geometry_msgs/PoseStamped.h>
+#include <geometry_msgs/TwistStamped.h>
+#include <geometry_msgs/WrenchStamped.h>
+#include <std_msgs/Float64MultiArray.h>
+
+namespace dvrk {
+
+    /*! Release the GIL for the lifetime of the object. */
+    class gil_release
+    {
+    public:
+        gil_release(void):
+            mState(PyEval_SaveThread())
+        {}
+        ~gil_release() {
+            PyEval_RestoreThread(mState);
+        }
+    private:
+        PyThreadState * mState;
+    };
+
+    /*! Latest values received on a topic.  Vectors are only resized
+      when the size changes so receiving a message doesn't allocate. */
+    class topic_buffer
+    {
+    public:
+        topic_buffer(void):
+            Counter(0),
+            Stamp(0.0),
+            Rows(0),
+            Columns(0)
+        {}
+
+        std::mutex Mutex;
+        std::condition_variable Condition;
+        unsigned long long Counter;
+        double Stamp;
+        std::vector<double> Position, Velocity, Effort;
+        // poses, twists and wrenches use Position
+        size_t Rows, Columns;
+    };
+
+    /*! roscpp must be initialized once per process, rospy uses its
+      own node so the native core is an anonymous node. */
+    void init(void)
+    {
+        if (!ros::isInitialized()) {
+            int argc = 0;
+            ros::init(argc, 0, "dvrk_python_core",
+                      ros::init_options::NoSigintHandler | ros::init_options::AnonymousName);
+        }
+    }
+
+    /*! Subscribers for one arm, see dvrk.arm in Python. */
+    class arm_core
+    {
+    public:
+        arm_core(const std::string & ros_namespace):
+            mInitialized((init(), true)),
+            mNodeHandle(ros_namespace),
+            mSpinner(1, &mQueue)
+        {
+            mNodeHandle.setCallbackQueue(&mQueue);
+            mSpinner.start();
+        }
+
+        ~arm_core() {
+            mSpinner.stop();
+            mSubscribers.clear();
+        }
+
+        void AddJointState(const std::string & topic) {
+            Subscribe<sensor_msgs::JointState>(topic, &arm_core::JointStateCallback);
+        }
+
+        void AddPose(const std::string & topic) {
+            Subscribe<geometry_msgs::PoseStamped>(topic, &arm_core::PoseCallback);
+        }
+
+        void AddTwist(const std::string & topic) {
+            Subscribe<geometry_msgs::TwistStamped>(topic, &arm_core::TwistCallback);
+        }
+
+        void AddWrench(const std::string & topic) {
+            Subscribe<geometry_msgs::WrenchStamped>(topic, &arm_core::WrenchCallback);
+        }
+
+        void AddMatrix(const std::string & topic) {
+            Subscribe<std_msgs::Float64MultiArray>(topic, &arm_core::MatrixCallback);
+        }
+
+        /*! Returns (position, velocity, effort) as tuples. */
+        boost::python::tuple JointState(const std::string & topic) {
+            topic_buffer & buffer = Buffer(topic);
+            std::lock_guard<std::mutex> lock(buffer.Mutex);
+            return boost::python::make_tuple(ToTuple(buffer.Position),
+                                             ToTuple(buffer.Velocity),
+                                             ToTuple(buffer.Effort));
+        }
+
+        /*! Returns (x, y, z, qx, qy, qz, qw) for poses, (linear,
+          angular) for twists and (force, torque) for wrenches. */
+        boost::python::tuple Vector(const std::string & topic) {
+            topic_buffer & buffer = Buffer(topic);
+            std::lock_guard<std::mutex> lock(buffer.Mutex);
+            return ToTuple(buffer.Position);
+        }
+
+        /*! Returns (rows, columns, data) with data row major. */
+        boost::python::tuple Matrix(const std::string & topic) {
+            topic_buffer & buffer = Buffer(topic);
+            std::lock_guard<std::mutex> lock(buffer.Mutex);
+            return boost::python::make_tuple(buffer.Rows, buffer.Columns,
+                                             ToTuple(buffer.Position));
+        }
+
+        /*! Number of messages received on the topic. */
+        unsigned long long Counter(const std::string & topic) {
+            topic_buffer & buffer = Buffer(topic);
+            std::lock_guard<std::mutex> lock(buffer.Mutex);
+            return buffer.Counter;
+        }
+
+        /*! Wait until more than counter messages have been received,
+          without the GIL.  Returns false on timeout. */
+        bool Wait(const std::string & topic,
+                  const unsigned long long counter,
+                  const double timeout) {
+            topic_buffer & buffer = Buffer(topic);
+            gil_release release;
+            std::unique_lock<std::mutex> lock(buffer.Mutex);
+            return buffer.Condition.wait_for(lock, std::chrono::duration<double>(timeout),
+                                             [&buffer, counter] { return buffer.Counter > counter; });
+        }
+
+    protected:
+        template <typename _message>
+        void Subscribe(const std::string & topic,
+                       void (arm_core::*callback)(topic_buffer &, const _message &)) {
+            if (mBuffers.find(topic) != mBuffers.end()) {
+                return;
+            }
+            topic_buffer * buffer = new topic_buffer;
+            mBuffers[topic].reset(buffer);
+            // topics are relative to the arm namespace, remove leading /
+            const std::string relative = (!topic.empty() && (topic[0] == '/')) ? topic.substr(1) : topic;
+            boost::function<void (const boost::shared_ptr<const _message> &)> function =
+                [this, buffer, callback](const boost::shared_ptr<const _message> & message) {
+                {
+                    std::lock_guard<std::mutex> lock(buffer->Mutex);
+                    (this->*callback)(*buffer, *message);
+                    ++(buffer->Counter);
+                }
+                buffer->Condition.notify_all();
+            };
+            mSubscribers.push_back(mNodeHandle.subscribe<_message>(relative, 1, function));
+        }
+
+        topic_buffer & Buffer(const std::string & topic) {
+            const BuffersType::iterator buffer = mBuffers.find(topic);
+            if (buffer == mBuffers.end()) {
+                PyErr_SetString(PyExc_KeyError, ("no subscriber for topic " + topic).c_str());
+                boost::python::throw_error_already_set();
+            }
+            return *(buffer->second);
+        }
+
+        static boost::python::tuple ToTuple(const std::vector<double> & values) {
+            PyObject * tuple = PyTuple_New(values.size());
+            for (size_t index = 0; index < values.size(); ++index) {
+                PyTuple_SET_ITEM(tuple, index, PyFloat_FromDouble(values[index]));
+            }
+            return boost::python::tuple(boost::python::handle<>(tuple));
+        }
+
+        static void Assign(std::vector<double> & destination, const std::vector<double> & source) {
+            destination.resize(source.size());
+            std::copy(source.begin(), source.end(), destination.begin());
+        }
+
+        void JointStateCallback(topic_buffer & buffer, const sensor_msgs::JointState & message) {
+            buffer.Stamp = message.header.stamp.toSec();
+            Assign(buffer.Position, message.position);
+            Assign(buffer.Velocity, message.velocity);
+            Assign(buffer.Effort, message.effort);
+        }
+
+        void PoseCallback(topic_buffer & buffer, const geometry_msgs::PoseStamped & message) {
+            buffer.Stamp = message.header.stamp.toSec();
+            buffer.Position.resize(7);
+            buffer.Position[0] = message.pose.position.x;
+            buffer.Position[1] = message.pose.position.y;
+            buffer.Position[2] = message.pose.position.z;
+            buffer.Position[3] = message.pose.orientation.x;
+            buffer.Position[4] = message.pose.orientation.y;
+            buffer.Position[5] = message.pose.orientation.z;
+            buffer.Position[6] = message.pose.orientation.w;
+        }
+
+        void TwistCallback(topic_buffer & buffer, const geometry_msgs::TwistStamped & message) {
+            buffer.Stamp = message.header.stamp.toSec();
+            buffer.Position.resize(6);
+            buffer.Position[0] = message.twist.linear.x;
+            buffer.Position[1] = message.twist.linear.y;
+            buffer.Position[2] = message.twist.linear.z;
+            buffer.Position[3] = message.twist.angular.x;
+            buffer.Position[4] = message.twist.angular.y;
+            buffer.Position[5] = message.twist.angular.z;
+        }
+
+        void WrenchCallback(topic_buffer & buffer, const geometry_msgs::WrenchStamped & message) {
+            buffer.Stamp = message.header.stamp.toSec();
+            buffer.Position.resize(6);
+            buffer.Position[0] = message.wrench.force.x;
+            buffer.Position[1] = message.wrench.force.y;
+            buffer.Position[2] = message.wrench.force.z;
+            buffer.Position[3] = message.wrench.torque.x;
+            buffer.Position[4] = message.wrench.torque.y;
+            buffer.Position[5] = message.wrench.torque.z;
+        }
+
+        void MatrixCallback(topic_buffer & buffer, const std_msgs::Float64MultiArray & message) {
+            if (message.layout.dim.size() != 2) {
+                return;
+            }
+            buffer.Rows = message.layout.dim[0].size;
+            buffer.Columns = message.layout.dim[1].size;
+            Assign(buffer.Position, message.data);
+        }
+
+        typedef std::map<std::string, std::unique_ptr<topic_buffer> > BuffersType;
+        BuffersType mBuffers;
+        // must be first, roscpp is initialized before the node handle is created
+        bool mInitialized;
+        ros::NodeHandle mNodeHandle;
+        ros::CallbackQueue mQueue;
+        ros::AsyncSpinner mSpinner;
+        std::vector<ros::Subscriber> mSubscribers;
+    };
+
+    /*! Monotonic time in seconds, used for all servo_stream timings. */
+    inline double monotonic_time(void)
+    {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return now.tv_sec + now.tv_nsec * 1.0e-9;
+    }
+
+    /*! Running statistics (count, min, max, mean and standard
+      deviation) without storing the samples. */
+    class running_statistics
+    {
+    public:
+        running_statistics(void) {
+            Reset();
+        }
+
+        void Reset(void) {
+            Count = 0;
+            Min = std::numeric_limits<double>::max();
+            Max = 0.0;
+            Mean = 0.0;
+            mM2 = 0.0;
+        }
+
+        void Add(const double value) {
+            ++Count;
+            const double delta = value - Mean;
+            Mean += delta / Count;
+            mM2 += delta * (value - Mean);
+            Min = std::min(Min, value);
+            Max = std::max(Max, value);
+        }
+
+        double StdDev(void) const {
+            return (Count > 1) ? std::sqrt(mM2 / (Count - 1)) : 0.0;
+        }
+
+        boost::python::dict ToDict(void) const {
+            boost::python::dict result;
+            result["count"] = Count;
+            result["min"] = (Count > 0) ? Min : 0.0;
+            result["max"] = Max;
+            result["mean"] = Mean;
+            result["std"] = StdDev();
+            return result;
+        }
+
+        unsigned long long Count;
+        double Min, Max, Mean;
+    private:
+        double mM2;
+    };
+
+    /*! Publish setpoints at a fixed rate from a native thread, see
+      dvrk.arm.stream_joint_positions and stream_positions.  Setpoints
+      are queued by Python (push) and the thread publishes one per
+      period on set_position_joint or set_position_cartesian.  The
+      thread sleeps until absolute deadlines (clock_nanosleep) so
+      errors don't accumulate and uses SCHED_FIFO if a priority is
+      given and the user is allowed to.
+
+      Statistics:
+      * jitter: lateness of each wake up compared to its deadline
+      * missed: periods skipped because the thread woke up more than a
+        period late, the stream doesn't try to catch up
+      * underruns: periods without setpoint while streaming, i.e. the
+        Python producer was too slow
+      * delay: time between publishing a setpoint and receiving it
+        back from the arm on state_joint_desired or
+        position_cartesian_desired, measured when the echoed setpoint
+        matches the published one within tolerance. */
+    class servo_stream
+    {
+    public:
+        servo_stream(const std::string & ros_namespace,
+                     const std::string & space,
+                     const double rate,
+                     const size_t queue_size,
+                     const int priority):
+            mInitialized((init(), true)),
+            mNodeHandle(ros_namespace),
+            mSpinner(1, &mQueue),
+            mCartesian(space == "cartesian"),
+            mPeriod(1.0 / rate),
+            mQueueSize(std::max(queue_size, static_cast<size_t>(1))),
+            mPriority(priority),
+            mTolerance(1.0e-5),
+            mRunning(false),
+            mEndOfInput(false),
+            mStreaming(false)
+        {
+            if (!mCartesian && (space != "joint")) {
+                PyErr_SetString(PyExc_ValueError, "space must be \"joint\" or \"cartesian\"");
+                boost::python::throw_error_already_set();
+            }
+            if (rate <= 0.0) {
+                PyErr_SetString(PyExc_ValueError, "rate must be positive");
+                boost::python::throw_error_already_set();
+            }
+            mNodeHandle.setCallbackQueue(&mQueue);
+            if (mCartesian) {
+                mPublisher = mNodeHandle.advertise<geometry_msgs::Pose>("set_position_cartesian", 1);
+                mSubscriber = mNodeHandle.subscribe<geometry_msgs::PoseStamped>
+                    ("position_cartesian_desired", 1,
+                     boost::function<void (const geometry_msgs::PoseStamped::ConstPtr &)>
+                     ([this](const geometry_msgs::PoseStamped::ConstPtr & message) {
+                         const geometry_msgs::Pose & pose = message->pose;
+                         const double echo[7] = {pose.position.x, pose.position.y, pose.position.z,
+                                                 pose.orientation.x, pose.orientation.y,
+                                                 pose.orientation.z, pose.orientation.w};
+                         Echo(echo, 7);
+                     }));
+            } else {
+                mPublisher = mNodeHandle.advertise<sensor_msgs::JointState>("set_position_joint", 1);
+                mSubscriber = mNodeHandle.subscribe<sensor_msgs::JointState>
+                    ("state_joint_desired", 1,
+                     boost::function<void (const sensor_msgs::JointState::ConstPtr &)>
+                     ([this](const sensor_msgs::JointState::ConstPtr & message) {
+                         Echo(message->position.data(), message->position.size());
+                     }));
+            }
+            mSpinner.start();
+        }
+
+        ~servo_stream() {
+            StopThread();
+            mSpinner.stop();
+        }
+
+        /*! Queue a setpoint, joint positions or (x, y, z, qx, qy, qz,
+          qw).  Blocks without the GIL while the queue is full, raises
+          RuntimeError if the queue is full and the thread is not
+          running. */
+        void Push(const boost::python::object & setpoint) {
+            const size_t size = boost::python::len(setpoint);
+            if (mCartesian && (size != 7)) {
+                PyErr_SetString(PyExc_ValueError, "cartesian setpoints must be (x, y, z, qx, qy, qz, qw)");
+                boost::python::throw_error_already_set();
+            }
+            std::vector<double> values(size);
+            for (size_t index = 0; index < size; ++index) {
+                values[index] = boost::python::extract<double>(setpoint[index]);
+            }
+            bool queued;
+            {
+                gil_release release;
+                std::unique_lock<std::mutex> lock(mMutex);
+                // timed wait so we don't block forever if the thread stops
+                while (!(queued = (mSetpoints.size() < mQueueSize)) && mRunning) {
+                    mCondition.wait_for(lock, std::chrono::milliseconds(100));
+                }
+                if (queued) {
+                    mSetpoints.push_back(std::move(values));
+                    mEndOfInput = false;
+                }
+            }
+            if (!queued) {
+                PyErr_SetString(PyExc_RuntimeError, "servo_stream: queue is full and thread is not running");
+                boost::python::throw_error_already_set();
+            }
+        }
+
+        /*! Wait, without the GIL, until the arm subscribes to the
+          setpoint topic then start the streaming thread.  Setpoints
+          published before would be lost.  Returns false if there is no
+          subscriber after timeout, the thread is not started. */
+        bool Start(const double timeout) {
+            if (mRunning) {
+                return true;
+            }
+            {
+                gil_release release;
+                const double end = monotonic_time() + timeout;
+                while (mPublisher.getNumSubscribers() == 0) {
+                    if (monotonic_time() >= end) {
+                        return false;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            }
+            mRunning = true;
+            mThread = std::thread(&servo_stream::Run, this);
+            return true;
+        }
+
+        /*! Mark the end of input and wait, without the GIL, until all
+          queued setpoints have been published.  Returns false on
+          timeout. */
+        bool Drain(const double timeout) {
+            gil_release release;
+            std::unique_lock<std::mutex> lock(mMutex);
+            mEndOfInput = true;
+            return mCondition.wait_for(lock, std::chrono::duration<double>(timeout),
+                                       [this] { return mSetpoints.empty() && !mStreaming; });
+        }
+
+        /*! Stop the thread, queued setpoints are discarded. */
+        void Stop(void) {
+            gil_release release;
+            StopThread();
+            std::lock_guard<std::mutex> lock(mMutex);
+            mSetpoints.clear();
+            mCondition.notify_all();
+        }
+
+        /*! Tolerance used to match echoed setpoints for delay. */
+        void SetTolerance(const double tolerance) {
+            std::lock_guard<std::mutex> lock(mStatisticsMutex);
+            mTolerance = tolerance;
+        }
+
+        void ResetStatistics(void) {
+            std::lock_guard<std::mutex> lock(mStatisticsMutex);
+            mJitter.Reset();
+            mDelay.Reset();
+            mStatistics = counters();
+            mPending.clear();
+        }
+
+        boost::python::dict Statistics(void) {
+            std::lock_guard<std::mutex> lock(mStatisticsMutex);
+            boost::python::dict result;
+            result["period"] = mPeriod;
+            result["periods"] = mStatistics.Periods;
+            result["published"] = mStatistics.Published;
+            result["missed"] = mStatistics.Missed;
+            result["underruns"] = mStatistics.Underruns;
+            result["jitter"] = mJitter.ToDict();
+            result["delay"] = mDelay.ToDict();
+            return result;
+        }
+
+    protected:
+        struct counters {
+            counters(void): Periods(0), Published(0), Missed(0), Underruns(0) {}
+            unsigned long long Periods, Published, Missed, Underruns;
+        };
+
+        struct pending_setpoint {
+            double Time;
+            std::vector<double> Values;
+        };
+
+        void StopThread(void) {
+            if (!mRunning) {
+                return;
+            }
+            mRunning = false;
+            mThread.join();
+        }
+
+        static void AddSeconds(timespec & time, const double seconds) {
+            const long long nanoseconds = time.tv_nsec + static_cast<long long>(seconds * 1.0e9);
+            time.tv_sec += nanoseconds / 1000000000LL;
+            time.tv_nsec = nanoseconds % 1000000000LL;
+        }
+
+        void Run(void) {
+            if (mPriority > 0) {
+                sched_param parameters;
+                parameters.sched_priority = mPriority;
+                if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters) != 0) {
+                    ROS_WARN("servo_stream: failed to set SCHED_FIFO priority %d, using default scheduler",
+                             mPriority);
+                }
+            }
+            // preallocated messages, no allocation while streaming
+            // unless the number of joints changes
+            sensor_msgs::JointState jointState;
+            geometry_msgs::Pose pose;
+            std::vector<double> setpoint;
+            pending_setpoint pending;
+
+            timespec deadline;
+            clock_gettime(CLOCK_MONOTONIC, &deadline);
+            while (mRunning) {
+                AddSeconds(deadline, mPeriod);
+                while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, 0) == EINTR) {}
+                const double now = monotonic_time();
+                double late = now - (deadline.tv_sec + deadline.tv_nsec * 1.0e-9);
+                // woke up too late, skip periods instead of bursting
+                unsigned long long missed = 0;
+                if (late > mPeriod) {
+                    missed = static_cast<unsigned long long>(late / mPeriod);
+                    AddSeconds(deadline, missed * mPeriod);
+                    late -= missed * mPeriod;
+                }
+
+                bool hasSetpoint = false;
+                bool underrun = false;
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    if (!mSetpoints.empty()) {
+                        setpoint.swap(mSetpoints.front());
+                        mSetpoints.pop_front();
+                        hasSetpoint = true;
+                        mStreaming = true;
+                    } else {
+                        underrun = mStreaming && !mEndOfInput;
+                        mStreaming = false;
+                    }
+                }
+                mCondition.notify_all();
+
+                if (hasSetpoint) {
+                    if (mCartesian) {
+                        pose.position.x = setpoint[0];
+                        pose.position.y = setpoint[1];
+                        pose.position.z = setpoint[2];
+                        pose.orientation.x = setpoint[3];
+                        pose.orientation.y = setpoint[4];
+                        pose.orientation.z = setpoint[5];
+                        pose.orientation.w = setpoint[6];
+                        mPublisher.publish(pose);
+                    } else {
+                        jointState.position.resize(setpoint.size());
+                        std::copy(setpoint.begin(), setpoint.end(), jointState.position.begin());
+                        mPublisher.publish(jointState);
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(mStatisticsMutex);
+                ++(mStatistics.Periods);
+                mStatistics.Missed += missed;
+                mJitter.Add(late);
+                if (underrun) {
+                    ++(mStatistics.Underruns);
+                }
+                if (hasSetpoint) {
+                    ++(mStatistics.Published);
+                    pending.Time = now;
+                    pending.Values.swap(setpoint);
+                    // bounded, setpoints never echoed (e.g. clamped by
+                    // the arm) are forgotten
+                    if (mPending.size() >= 100) {
+                        mPending.pop_front();
+                    }
+                    mPending.push_back(std::move(pending));
+                }
+            }
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStreaming = false;
+            mCondition.notify_all();
+        }
+
+        /*! Called by the spinner thread when the arm publishes its
+          desired state, match with the oldest published setpoints. */
+        void Echo(const double * values, const size_t size) {
+            const double now = monotonic_time();
+            std::lock_guard<std::mutex> lock(mStatisticsMutex);
+            for (std::deque<pending_setpoint>::iterator pending = mPending.begin();
+                 pending != mPending.end();
+                 ++pending) {
+                if (Matches(pending->Values, values, size)) {
+                    mDelay.Add(now - pending->Time);
+                    // older setpoints have been overwritten by this one
+                    mPending.erase(mPending.begin(), pending + 1);
+                    return;
+                }
+            }
+        }
+
+        bool Matches(const std::vector<double> & setpoint,
+                     const double * values, const size_t size) const {
+            if (setpoint.size() != size) {
+                return false;
+            }
+            double error = 0.0;
+            for (size_t index = 0; index < size; ++index) {
+                error = std::max(error, std::abs(setpoint[index] - values[index]));
+            }
+            if (mCartesian && (error > mTolerance)) {
+                // q and -q are the same rotation
+                error = 0.0;
+                for (size_t index = 0; index < size; ++index) {
+                    const double sign = (index < 3) ? 1.0 : -1.0;
+                    error = std::max(error, std::abs(setpoint[index] - sign * values[index]));
+                }
+            }
+            return error <= mTolerance;
+        }
+
+        // must be first, roscpp is initialized before the node handle is created
+        bool mInitialized;
+        ros::NodeHandle mNodeHandle;
+        ros::CallbackQueue mQueue;
+        ros::AsyncSpinner mSpinner;
+        ros::Publisher mPublisher;
+        ros::Subscriber mSubscriber;
+        bool mCartesian;
+        double mPeriod;
+        size_t mQueueSize;
+        int mPriority;
+        double mTolerance;
+
+        std::thread mThread;
+        std::atomic<bool> mRunning;
+
+        // setpoints queued by Python, protected by mMutex
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::deque<std::vector<double> > mSetpoints;
+        bool mEndOfInput;
+        bool mStreaming;
+
+        // statistics, protected by mStatisticsMutex
+        std::mutex mStatisticsMutex;
+        counters mStatistics;
+        running_statistics mJitter;
+        running_statistics mDelay;
+        std::deque<pending_setpoint> mPending;
+    };
+}
+
+BOOST_PYTHON_MODULE(_arm_core)
+{
+    using namespace boost::python;
+#if PY_VERSION_HEX < 0x03070000
+    PyEval_InitThreads();
+#endif
+    def("init", &dvrk::init);
+    class_<dvrk::arm_core, boost::noncopyable>("arm_core", init<std::string>())
+        .def("add_joint_state", &dvrk::arm_core::AddJointState)
+        .def("add_pose", &dvrk::arm_core::AddPose)
+        .def("add_twist", &dvrk::arm_core::AddTwist)
+        .def("add_wrench", &dvrk::arm_core::AddWrench)
+        .def("add_matrix", &dvrk::arm_core::AddMatrix)
+        .def("joint_state", &dvrk::arm_core::JointState)
+        .def("vector", &dvrk::arm_core::Vector)
+        .def("matrix", &dvrk::arm_core::Matrix)
+        .def("counter", &dvrk::arm_core::Counter)
+        .def("wait", &dvrk::arm_core::Wait);
+    class_<dvrk::servo_stream, boost::noncopyable>("servo_stream",
+                                                   init<std::string, std::string, double, size_t, int>())
+        .def("push", &dvrk::servo_stream::Push)
+        .def("start", &dvrk::servo_stream::Start, (arg("timeout") = 1.0))
+        .def("drain", &dvrk::servo_stream::Drain)
+        .def("stop", &dvrk::servo_stream::Stop)
+        .def("set_tolerance", &dvrk::servo_stream::SetTolerance)
+        .def("reset_statistics", &dvrk::servo_stream::ResetStatistics)
+        .def("statistics", &dvrk::servo_stream::Statistics);
+}
@@ -19,8 +19,8 @@ http://www.cisst.org/cisst/license.txt.
 #ifndef _dvrk_add_topics_functions_h
 #define _dvrk_add_topics_functions_h
 
-#include <cisst_ros_bridge/mtsROSBridge.h>
-#include <dvrk_utilities/dvrk_topics_version.h>
+#include <dvrk_utilities/dvrk_bridge.h>
+#include <dvrk_utilities/dvrk_topics_registry.h>
 
 namespace dvrk {
 
@@ -28,9 +28,9 @@ namespace dvrk {
       console.  Topics are /off, /home, /teleop/start, /teleop/stop,
       /teleop/set_scale and /teleop_scale.
     */
-    void add_topics_console(mtsROSBridge & bridge,
+    void add_topics_console(dvrk::bridge & bridge,
                                const std::string & ros_namespace,
-                               const dvrk_topics_version::version version);
+                               const dvrk::topics_versions & versions);
 
     /*! This method connects all the required interfaces for the
       console, it must be used after add_topics_console. */
@@ -44,9 +44,9 @@ namespace dvrk {
       1.3, sensor_msgs::Joy after 1.4.  Topics are /clutch_state,
       /coag_state, /camera_state, /cam_plus_state,
       /cam_minus_state. */
-    void add_topics_footpedals(mtsROSBridge & bridge,
+    void add_topics_footpedals(dvrk::bridge & bridge,
                                const std::string & ros_namespace,
-                               const dvrk_topics_version::version version);
+                               const dvrk::topics_versions & versions);
 
     /*! This method connects all the required interfaces for the foot
       pedals, it must be used after add_topics_footpedals. */
@@ -54,26 +54,63 @@ namespace dvrk {
                                    const std::string & io_component_name);
 
     /*! Add all the topics common to all dVRK arms (ECM, MTM and
-      PSM). */
-    void add_topics_arm(mtsROSBridge & bridge,
+      PSM).  Joint and cartesian states are in the fast rate class,
+      local cartesian positions, velocities and wrenches in the
+      medium class and jacobians in the slow class (see
+      dvrk::bridge).  Jacobians are also available on demand using
+      the service query_jacobian (see dvrk::jacobian_service).  If multiple versions are requested, the topics
+      for all versions are added and each command is read once per
+      cycle (see dvrk::add_topics_from_table). */
+    void add_topics_arm(dvrk::bridge & bridge,
                         const std::string & ros_namespace,
                         const std::string & arm_component_name,
-                        const dvrk_topics_version::version version);
+                        const dvrk::topics_versions & versions);
+
+    /*! Connect the required interface used by the Jacobian service
+      (query_jacobian) added in add_topics_arm. */
+    void connect_bridge_arm_jacobian(const std::string & bridge_name,
+                                     const std::string & arm_name,
+                                     const std::string & arm_component_name,
+                                     const std::string & arm_interface_name);
+
+    /*! Connect the required interfaces used by the servo
+      subscribers added in add_topics_arm.  Servo commands only
+      deliver the latest setpoint received (see
+      dvrk::bridge::AddLatestSubscriberToCommandWrite), the arm's
+      "ExecOut" interface is used to deliver them once per arm
+      cycle. */
+    void connect_bridge_arm_servo(const std::string & bridge_name,
+                                  const std::string & arm_name,
+                                  const std::string & arm_component_name,
+                                  const std::string & arm_interface_name);
+
+    /*! Add the "state" topic, i.e. a dvrk_robot::ArmState message
+      with all the arm's state read in a single pass.  Uses the
+      required interface arm_component_name + "-state", see
+      connect_bridge_arm_state. */
+    void add_topics_arm_state(dvrk::bridge & bridge,
+                              const std::string & ros_namespace,
+                              const std::string & arm_component_name);
+
+    void connect_bridge_arm_state(const std::string & bridge_name,
+                                  const std::string & arm_name,
+                                  const std::string & arm_component_name,
+                                  const std::string & arm_interface_name);
 
     /*! Add all the topics common to all arms (see add_topics_arm) as
       well as MTM specific topics. */
-    void add_topics_mtm(mtsROSBridge & bridge,
+    void add_topics_mtm(dvrk::bridge & bridge,
                         const std::string & ros_namespace,
                         const std::string & mtm_component_name,
-                        const dvrk_topics_version::version version);
+                        const dvrk::topics_versions & versions);
 
     /*! This is a temporary fix until we have a standardized API for
       all MTMs defined in cisst/SAW.  This will then be moved to
       either cisst-ros or a new saw-ros library. */
-    void add_topics_mtm_generic(mtsROSBridge & bridge,
+    void add_topics_mtm_generic(dvrk::bridge & bridge,
                                 const std::string & ros_namespace,
                                 const std::string & mtm_component_name,
-                                const dvrk_topics_version::version version);
+                                const dvrk::topics_versions & versions);
 
     /*! This method connects all the required interfaces for an MTM
       arm, it must be used after add_topics_mtm. */
@@ -82,12 +119,19 @@ namespace dvrk {
                             const std::string & mtm_component_name,
                             const std::string & mtm_interface_name);
 
+    /*! Connects the required interfaces for a generic MTM, it must
+      be used after add_topics_mtm_generic. */
+    void connect_bridge_mtm_generic(const std::string & bridge_name,
+                                    const std::string & arm_name,
+                                    const std::string & mtm_component_name,
+                                    const std::string & mtm_interface_name);
+
     /*! Add all the topics common to all arms (see add_topics_arm) as
       well as PSM specific topics. */
-    void add_topics_psm(mtsROSBridge & bridge,
+    void add_topics_psm(dvrk::bridge & bridge,
                         const std::string & ros_namespace,
                         const std::string & psm_component_name,
-                        const dvrk_topics_version::version version);
+                        const dvrk::topics_versions & versions);
 
     /*! This method connects all the required interfaces for a PSM
       arm, it must be used after add_topics_psm. */
@@ -97,10 +141,10 @@ namespace dvrk {
                             const std::string & psm_interface_name);
 
     /*! Add all the IO topics for physical dVRK PSMs. */
-    void add_topics_psm_io(mtsROSBridge & bridge,
+    void add_topics_psm_io(dvrk::bridge & bridge,
                            const std::string & ros_namespace,
                            const std::string & arm_name,
-                           const dvrk_topics_version::version version);
+                           const dvrk::topics_versions & versions);
 
     /*! This method connects all the required interfaces for the PSM's
         IOs, it must be used after add_topics_psm_io. */
@@ -110,10 +154,10 @@ namespace dvrk {
 
     /*! Add all the topics common to all arms (see add_topics_arm) as
       well as ECM specific topics. */
-    void add_topics_ecm(mtsROSBridge & bridge,
+    void add_topics_ecm(dvrk::bridge & bridge,
                         const std::string & ros_namespace,
                         const std::string & ecm_component_name,
-                        const dvrk_topics_version::version version);
+                        const dvrk::topics_versions & versions);
 
     /*! This method connects all the required interfaces for an ECM
       arm, it must be used after add_topics_ecm. */
@@ -123,10 +167,10 @@ namespace dvrk {
                             const std::string & ecm_interface_name);
 
     /*! Add all the IO topics for physical dVRK ECMs. */
-    void add_topics_ecm_io(mtsROSBridge & bridge,
+    void add_topics_ecm_io(dvrk::bridge & bridge,
                            const std::string & ros_namespace,
                            const std::string & arm_name,
-                           const dvrk_topics_version::version version);
+                           const dvrk::topics_versions & versions);
 
     /*! This method connects all the required interfaces for the ECM's
         IOs, it must be used after add_topics_ecm_io. */
@@ -135,10 +179,10 @@ namespace dvrk {
                                const std::string & io_component_name);
 
     /*! Add all the topics related to tele-op component. */
-    void add_topics_teleop(mtsROSBridge & bridge,
+    void add_topics_teleop(dvrk::bridge & bridge,
                            const std::string & ros_namespace,
                            const std::string & teleop_component_name,
-                           const dvrk_topics_version::version version);
+                           const dvrk::topics_versions & versions);
 
     /*! This method connects all the required interfaces for a teleop
       component, it must be used after add_topics_teleop. */
@@ -146,10 +190,10 @@ namespace dvrk {
                                const std::string & teleop_component_name);
 
     /*! Add all the topics related to the setup joints (SUJ) */
-    void add_topics_suj(mtsROSBridge & bridge,
+    void add_topics_suj(dvrk::bridge & bridge,
                         const std::string & ros_namespace,
                         const std::string & arm_name,
-                        const dvrk_topics_version::version version);
+                        const dvrk::topics_versions & versions);
 
     /*! This method connects all the required interfaces for a SUJ
         component, it must be used after add_topics_suj. */
@@ -159,9 +203,9 @@ namespace dvrk {
 
     /*! This method adds topics from the IO level for the whole
       system. */
-    void add_topics_io(mtsROSBridge & bridge,
+    void add_topics_io(dvrk::bridge & bridge,
                        const std::string & ros_namespace,
-                       const dvrk_topics_version::version version);
+                       const dvrk::topics_versions & versions);
 
     /*! This method connects all the required interfaces for IOs, it
       must be used after add_topics_io. */
@@ -174,10 +218,10 @@ namespace dvrk {
       MTM, ECM or PSM topics to ensure that the system is properly
       initialized.  The topics added are mostly useful for low level
       data collection and debugging. */
-    void add_topics_io(mtsROSBridge & bridge,
+    void add_topics_io(dvrk::bridge & bridge,
                        const std::string & ros_namespace,
                        const std::string & arm_name,
-                        const dvrk_topics_version::version version);
+                        const dvrk::topics_versions & versions);
 
     /*! This method connects all the required interfaces for an arm
       IOs, it must be used after add_topics_io. */
@@ -185,7 +229,25 @@ namespace dvrk {
                            const std::string & io_component_name,
                            const std::string & arm_name);
 
-    void add_tf_arm(mtsROSBridge & tf_bridge,
+    /*! This method adds a publisher capturing every IO sample for
+      a given arm, see dvrk::io_capture_publisher.  Samples are
+      published in chunks of samples_per_chunk on
+      ros_namespace + "/capture". */
+    void add_topics_io_capture(dvrk::bridge & bridge,
+                               const std::string & ros_namespace,
+                               const std::string & arm_name,
+                               const size_t samples_per_chunk,
+                               const size_t buffer_size);
+
+    /*! This method connects all the required interfaces for an arm
+      IO capture, it must be used after add_topics_io_capture. */
+    void connect_bridge_io_capture(const std::string & bridge_name,
+                                   const std::string & io_component_name,
+                                   const std::string & arm_name);
+
+    /*! Add the arm's measured_cp to the bridge's tf2 frames, see
+      dvrk::bridge::AddTfPublisher. */
+    void add_tf_arm(dvrk::bridge & tf_bridge,
                     const std::string & arm_name);
     
     void connect_tf_arm(const std::string & tf_bridge_name,
@@ -193,7 +255,9 @@ namespace dvrk {
                         const std::string & arm_component_name,
                         const std::string & arm_interface_name);
 
-    void add_tf_suj(mtsROSBridge & tf_bridge,
+    /*! Add the base frame of an arm mounted on the SUJ as a static
+      frame, it is only published on /tf_static when the SUJ moves. */
+    void add_tf_suj(dvrk::bridge & tf_bridge,
                     const std::string & arm_name);
     
     void connect_tf_suj(const std::string & tf_bridge_name,
@@ -0,0 +1,49 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-24
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_arm_state_h
+#define _dvrk_arm_state_h
+
+/* This file must compile as C, it is used by the shared state reader
+   library (see dvrk_shared_state.h) */
+
+#include <stdint.h>
+
+/*! Maximum number of joints in a dvrk_arm_state, unused joints are
+  set to 0. */
+#define DVRK_ARM_STATE_MAXIMUM_JOINTS 10
+
+/*! Fixed size arm state, used by the state recorder files and the
+  shared memory state.  Cartesian positions are stored as the
+  translation followed by the rotation matrix, row major.  Valid is 1
+  if the joint and cartesian measured positions are valid. */
+typedef struct {
+    double Timestamp;
+    uint32_t NumberOfJoints;
+    uint32_t Valid;
+    double MeasuredPosition[DVRK_ARM_STATE_MAXIMUM_JOINTS];
+    double MeasuredVelocity[DVRK_ARM_STATE_MAXIMUM_JOINTS];
+    double MeasuredEffort[DVRK_ARM_STATE_MAXIMUM_JOINTS];
+    double SetpointPosition[DVRK_ARM_STATE_MAXIMUM_JOINTS];
+    double SetpointEffort[DVRK_ARM_STATE_MAXIMUM_JOINTS];
+    double MeasuredCP[12];
+    double SetpointCP[12];
+    double BodyMeasuredCF[6];
+} dvrk_arm_state;
+
+#endif /* _dvrk_arm_state_h */
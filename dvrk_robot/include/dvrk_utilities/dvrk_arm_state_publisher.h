@@ -0,0 +1,99 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-13
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_arm_state_publisher_h
+#define _dvrk_arm_state_publisher_h
+
+#include <cisstVector/vctDynamicMatrixTypes.h>
+#include <cisstParameterTypes/prmStateJoint.h>
+#include <cisstParameterTypes/prmPositionCartesianGet.h>
+#include <cisstParameterTypes/prmVelocityCartesianGet.h>
+#include <cisstParameterTypes/prmForceCartesianGet.h>
+
+#include <dvrk_utilities/dvrk_bridge.h>
+#include <dvrk_robot/ArmState.h>
+
+namespace dvrk {
+
+    /*! Publisher for the dvrk_robot::ArmState message, i.e. all the
+      arm's state in a single message.  All the samples are read in
+      one pass and the timestamps of the first and last samples read
+      are compared to detect if the arm's state table has advanced in
+      between.  If so, the samples are read again (up to
+      MaximumReads times) so clients get a consistent snapshot
+      without having to synchronize multiple topics.
+
+      The gripper and Jacobians are optional, fields are left empty if
+      the arm doesn't provide them.  The "on change" mode is not
+      supported by this publisher. */
+    class arm_state_publisher: public publisher_base
+    {
+    public:
+        arm_state_publisher(const std::string & topic_name,
+                            const dvrk_topics_rate::rate rate,
+                            const uint32_t queue_size);
+
+        void Advertise(ros::NodeHandle & node_handle);
+
+        /*! Add all the functions used by the publisher to the
+          required interface. */
+        bool AddFunctions(mtsInterfaceRequired * interface_required);
+
+        bool Execute(void);
+
+        /*! Number of times the samples had to be read again because
+          the arm's state changed while reading. */
+        inline size_t NumberOfRereads(void) const {
+            return mNumberOfRereads;
+        }
+
+        enum {MaximumReads = 3};
+
+    protected:
+        bool Read(void);
+
+        struct {
+            mtsFunctionRead GetStateJoint;
+            mtsFunctionRead GetStateJointDesired;
+            mtsFunctionRead GetPositionCartesian;
+            mtsFunctionRead GetPositionCartesianDesired;
+            mtsFunctionRead GetPositionCartesianLocal;
+            mtsFunctionRead GetPositionCartesianLocalDesired;
+            mtsFunctionRead GetVelocityCartesian;
+            mtsFunctionRead GetWrenchBody;
+            mtsFunctionRead GetJacobianBody;
+            mtsFunctionRead GetJacobianSpatial;
+            mtsFunctionRead GetStateGripper;
+        } Arm;
+
+        prmStateJoint mMeasuredJS, mSetpointJS, mGripperMeasuredJS;
+        prmPositionCartesianGet mMeasuredCP, mSetpointCP, mLocalMeasuredCP, mLocalSetpointCP;
+        prmVelocityCartesianGet mMeasuredCV;
+        prmForceCartesianGet mBodyMeasuredCF;
+        vctDoubleMat mBodyJacobian, mSpatialJacobian;
+
+        size_t mNumberOfRereads;
+        // stamped messages used for conversions, only the payload is
+        // copied in the arm state message
+        geometry_msgs::TransformStamped mTransformStamped;
+        geometry_msgs::TwistStamped mTwistStamped;
+        geometry_msgs::WrenchStamped mWrenchStamped;
+    };
+}
+
+#endif // _dvrk_arm_state_publisher_h
@@ -0,0 +1,62 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-24
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_arm_state_sampler_h
+#define _dvrk_arm_state_sampler_h
+
+#include <cisstMultiTask/mtsInterfaceRequired.h>
+#include <cisstMultiTask/mtsFunctionRead.h>
+#include <cisstParameterTypes/prmStateJoint.h>
+#include <cisstParameterTypes/prmPositionCartesianGet.h>
+#include <cisstParameterTypes/prmForceCartesianGet.h>
+
+#include <dvrk_utilities/dvrk_arm_state.h>
+
+namespace dvrk {
+
+    /*! Read an arm's state and copy it in a fixed size
+      dvrk_arm_state.  Used by the state recorder and the shared
+      memory state, both sample the arm from the arm's thread (see
+      "RunEvent"). */
+    class arm_state_sampler
+    {
+    public:
+        bool AddFunctions(mtsInterfaceRequired * interface_required);
+
+        /*! Read all the fields from the arm, returns false if any
+          read failed.  All fields of state are overwritten. */
+        bool Sample(dvrk_arm_state & state);
+
+    protected:
+        static void CopyFrame(const vctFrm3 & frame, double * destination);
+
+        struct {
+            mtsFunctionRead GetStateJoint;
+            mtsFunctionRead GetStateJointDesired;
+            mtsFunctionRead GetPositionCartesian;
+            mtsFunctionRead GetPositionCartesianDesired;
+            mtsFunctionRead GetWrenchBody;
+        } Arm;
+
+        prmStateJoint mMeasuredJS, mSetpointJS;
+        prmPositionCartesianGet mMeasuredCP, mSetpointCP;
+        prmForceCartesianGet mBodyMeasuredCF;
+    };
+}
+
+#endif // _dvrk_arm_state_sampler_h
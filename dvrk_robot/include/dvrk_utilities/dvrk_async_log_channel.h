@@ -0,0 +1,160 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-06-05
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_async_log_channel_h
+#define _dvrk_async_log_channel_h
+
+#include <atomic>
+#include <fstream>
+#include <list>
+#include <map>
+#include <streambuf>
+#include <thread>
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaMutex.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+
+#include <dvrk_utilities/dvrk_thread_settings.h>
+
+namespace dvrk {
+
+    /*! Log channel writing to a file without blocking the threads
+      logging, to be added to cmnLogger using Stream().  Each thread
+      writing to the channel gets its own ring buffer, allocated on
+      the thread's first log.  Lines are copied in the buffer without
+      lock nor memory allocation and a low priority writer thread
+      drains all buffers to the file every flush period.  If a
+      thread's buffer is full, lines are dropped and counted, the
+      number of lines dropped is written in the file by the writer
+      thread.  Lines longer than MaximumLineSize are truncated. */
+    class async_log_channel
+    {
+    public:
+        enum {MaximumLineSize = 1024};
+
+        async_log_channel(const std::string & file_name,
+                          const size_t buffer_size_per_thread = 64 * 1024,
+                          const double & flush_period_in_seconds = 100.0 * cmn_ms);
+
+        ~async_log_channel();
+
+        /*! Settings for the writer thread, by default the default
+          scheduler with nice 10.  Must be set before Start. */
+        inline void SetWriterThreadSettings(const thread_settings & settings) {
+            mWriterThreadSettings = settings;
+        }
+
+        /*! Open the file and start the writer thread.  Lines logged
+          before are kept in the buffers.  Returns false if the file
+          can't be opened. */
+        bool Start(void);
+
+        /*! Write all pending lines, stop the writer thread and close
+          the file.  The channel should be removed from cmnLogger
+          first. */
+        void Stop(void);
+
+        /*! Stream to add to cmnLogger, e.g.
+          cmnLogger::AddChannel(channel.Stream()).  The stream can be
+          used by multiple threads at once. */
+        inline std::ostream & Stream(void) {
+            return mStream;
+        }
+
+        /*! Total number of lines dropped because a buffer was full. */
+        inline size_t Dropped(void) const {
+            return mDropped.load();
+        }
+
+    protected:
+        /*! Ring buffer and current line for a given thread, only the
+          owning thread writes and only the writer thread reads. */
+        class thread_buffer
+        {
+        public:
+            thread_buffer(const size_t size);
+            ~thread_buffer();
+
+            char * Data;
+            size_t Size;
+            // monotonic counters, position in Data is modulo Size
+            std::atomic<size_t> Head;
+            std::atomic<size_t> Tail;
+            char Line[MaximumLineSize];
+            size_t LineSize;
+        };
+
+        /*! Stream buffer without put area, all characters are sent to
+          the calling thread's buffer. */
+        class stream_buffer: public std::streambuf
+        {
+        public:
+            stream_buffer(async_log_channel * channel);
+
+        protected:
+            int_type overflow(int_type character);
+            std::streamsize xsputn(const char * characters, std::streamsize count);
+            int sync(void);
+
+            async_log_channel * mChannel;
+        };
+
+        /*! Buffer for the calling thread, created on first use. */
+        thread_buffer * Buffer(void);
+
+        /*! Append characters to the current line of the calling
+          thread, complete lines are committed to the thread's
+          buffer. */
+        void Append(const char * characters, const size_t count);
+
+        /*! Move the current line of a thread in its buffer, drop it if
+          there is not enough space. */
+        void Commit(thread_buffer * buffer);
+
+        /*! Write all pending lines to the file, called by the writer
+          thread. */
+        void Drain(void);
+
+        void * Run(void * argument);
+
+        std::string mFileName;
+        size_t mBufferSize;
+        double mFlushPeriod;
+        std::ofstream mFile;
+        stream_buffer mStreamBuffer;
+        std::ostream mStream;
+
+        // buffers are only removed when the channel is deleted
+        osaMutex mBuffersMutex;
+        typedef std::map<std::thread::id, thread_buffer *> BuffersType;
+        BuffersType mBuffers;
+
+        std::atomic<size_t> mDropped;
+        size_t mDroppedReported;
+        std::string mEntry;
+
+        thread_settings mWriterThreadSettings;
+        osaThread mWriterThread;
+        osaThreadSignal mWriterSignal;
+        std::atomic<bool> mRunning;
+    };
+}
+
+#endif // _dvrk_async_log_channel_h
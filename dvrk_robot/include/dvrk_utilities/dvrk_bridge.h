@@ -0,0 +1,732 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-02
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_bridge_h
+#define _dvrk_bridge_h
+
+#include <list>
+#include <map>
+#include <vector>
+
+#include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisst_ros_bridge/mtsROSBridge.h>
+#include <dvrk_utilities/dvrk_topics_rate.h>
+#include <dvrk_utilities/dvrk_sample_compare.h>
+#include <dvrk_utilities/dvrk_thread_settings.h>
+#include <dvrk_utilities/dvrk_latest_command.h>
+#include <dvrk_utilities/dvrk_latency_histogram.h>
+
+#include <ros/callback_queue.h>
+#include <std_msgs/UInt32.h>
+
+namespace dvrk {
+
+    class tf_publisher;
+    class jacobian_service;
+    class timing_monitor;
+
+    /*! Base class for all publishers managed by dvrk::bridge.  Each
+      publisher is assigned a rate class, the bridge only executes
+      the publishers whose class is due for the current cycle. */
+    class publisher_base
+    {
+    public:
+        publisher_base(const std::string & topic_name,
+                       const dvrk_topics_rate::rate rate,
+                       const uint32_t queue_size = 1):
+            mTopicName(topic_name),
+            mQueueSize(queue_size),
+            mRate(rate),
+            mOnChange(false),
+            mDeadband(0.0),
+            mLazy(true)
+        {}
+
+        virtual ~publisher_base() {}
+
+        /*! Advertise the topic, this is called by the bridge when the
+          publisher is added or when the bridge starts if the
+          advertisement is deferred (see bridge::SetDeferAdvertisement). */
+        virtual void Advertise(ros::NodeHandle & node_handle) = 0;
+
+        /*! Read from the cisst command, convert and publish.  Returns
+          false if the read or conversion failed. */
+        virtual bool Execute(void) = 0;
+
+        inline const std::string & TopicName(void) const {
+            return mTopicName;
+        }
+
+        inline dvrk_topics_rate::rate Rate(void) const {
+            return mRate;
+        }
+
+        inline void SetRate(const dvrk_topics_rate::rate rate) {
+            mRate = rate;
+        }
+
+        /*! Only publish when the sample read has changed since the
+          last publication, i.e. new timestamp and valid.  If the
+          deadband is greater than 0, the distance between the new
+          sample and the last one published must also be greater than
+          the deadband (see dvrk::sample_distance).  The latest
+          sample is also published when the number of subscribers
+          grows so new subscribers don't wait for the next change. */
+        inline void SetOnChange(const bool on_change,
+                                const double & deadband = 0.0) {
+            mOnChange = on_change;
+            mDeadband = deadband;
+        }
+
+        /*! When lazy, the publisher doesn't read nor convert data if
+          there is no subscriber.  Since the number of subscribers is
+          checked on every execution, publication resumes on the
+          first cycle after a subscriber connects.  This is the
+          default. */
+        inline void SetLazy(const bool lazy) {
+            mLazy = lazy;
+        }
+
+        /*! Histogram of the time between the sample's timestamp (state
+          table) and its publication. */
+        inline latency_histogram & Latency(void) {
+            return mLatency;
+        }
+
+    protected:
+        /*! Add the current latency to the histogram, timestamps less
+          or equal to 0 (i.e. not set) are ignored. */
+        inline void RecordLatency(const double & sample_timestamp) {
+            if (sample_timestamp > 0.0) {
+                mLatency.Add(mtsManagerLocal::GetInstance()->GetTimeServer().GetRelativeTime()
+                             - sample_timestamp);
+            }
+        }
+
+        std::string mTopicName;
+        uint32_t mQueueSize;
+        dvrk_topics_rate::rate mRate;
+        bool mOnChange;
+        double mDeadband;
+        bool mLazy;
+        ros::Publisher mPublisher;
+        latency_histogram mLatency;
+    };
+
+    /*! Read command shared by all the publishers using the same
+      cisst command, i.e. when the same data is published on multiple
+      topics (see bridge::AddPublisherFromCommandRead).  The command
+      is executed at most once per bridge cycle, the bridge calls
+      Reset at the beginning of each cycle. */
+    class command_read_source_base
+    {
+    public:
+        command_read_source_base(void):
+            mRead(false),
+            mResult(false)
+        {}
+
+        virtual ~command_read_source_base() {}
+
+        inline void Reset(void) {
+            mRead = false;
+        }
+
+        mtsFunctionRead Function;
+
+    protected:
+        bool mRead;
+        bool mResult;
+    };
+
+    template <typename _mtsType>
+    class command_read_source: public command_read_source_base
+    {
+    public:
+        /*! Execute the read command if it hasn't been executed since
+          the last Reset.  Returns the result of the read. */
+        inline bool Read(void) {
+            if (!mRead) {
+                mResult = Function(mData).IsOK();
+                mRead = true;
+            }
+            return mResult;
+        }
+
+        inline const _mtsType & Data(void) const {
+            return mData;
+        }
+
+    protected:
+        _mtsType mData;
+    };
+
+    /*! Equivalent of mtsROSCommandReadPublisher for dvrk::bridge.
+      The data is read using a source possibly shared with other
+      publishers. */
+    template <typename _mtsType, typename _rosType>
+    class command_read_publisher: public publisher_base
+    {
+    public:
+        command_read_publisher(command_read_source<_mtsType> * source,
+                               const std::string & topic_name,
+                               const dvrk_topics_rate::rate rate,
+                               const uint32_t queue_size):
+            publisher_base(topic_name, rate, queue_size),
+            mSource(source),
+            mFirst(true),
+            mNumberOfSubscribers(0)
+        {}
+
+        void Advertise(ros::NodeHandle & node_handle) {
+            mPublisher = node_handle.advertise<_rosType>(mTopicName, mQueueSize);
+        }
+
+        bool Execute(void) {
+            if (mLazy || mOnChange) {
+                const uint32_t subscribers = mPublisher.getNumSubscribers();
+                // make sure new subscribers get a message even if the
+                // data has not changed, lazy or not
+                if (subscribers > mNumberOfSubscribers) {
+                    mFirst = true;
+                }
+                mNumberOfSubscribers = subscribers;
+                if (mLazy && (subscribers == 0)) {
+                    return true;
+                }
+            }
+            if (!mSource->Read()) {
+                return false;
+            }
+            const _mtsType & cisstData = mSource->Data();
+            if (mOnChange && !Changed(cisstData)) {
+                return true;
+            }
+            // publish a new message using a shared pointer so
+            // subscribers in the same process (e.g. nodelets) receive
+            // it without serialization nor copy
+            typename _rosType::Ptr rosData(new _rosType);
+            if (mtsCISSTToROS(cisstData, *rosData, mTopicName)) {
+                mPublisher.publish(rosData);
+                RecordLatency(dvrk::sample_timestamp(cisstData));
+                if (mOnChange) {
+                    mLastPublished = cisstData;
+                    mFirst = false;
+                }
+                return true;
+            }
+            return false;
+        }
+
+    protected:
+        bool Changed(const _mtsType & cisstData) const {
+            if (!dvrk::sample_valid(cisstData)) {
+                return false;
+            }
+            if (mFirst) {
+                return true;
+            }
+            const double timestamp = dvrk::sample_timestamp(cisstData);
+            if ((timestamp != 0.0)
+                && (timestamp == dvrk::sample_timestamp(mLastPublished))) {
+                return false;
+            }
+            if (mDeadband > 0.0) {
+                return (dvrk::sample_distance(cisstData, mLastPublished) > mDeadband);
+            }
+            return true;
+        }
+
+        command_read_source<_mtsType> * mSource;
+        _mtsType mLastPublished;
+        bool mFirst;
+        uint32_t mNumberOfSubscribers;
+    };
+
+    /*! Base class for command_write_subscriber. */
+    class command_write_subscriber_base
+    {
+    public:
+        virtual ~command_write_subscriber_base() {}
+
+    protected:
+        ros::Subscriber mSubscriber;
+    };
+
+    /*! Equivalent of mtsROSSubscriberWrite for dvrk::bridge.  The
+      write function is owned by the bridge and can be shared by
+      multiple subscribers, i.e. the same command can be used for
+      multiple topics (see bridge::AddSubscriberToCommandWrite). */
+    template <typename _mtsType, typename _rosType>
+    class command_write_subscriber: public command_write_subscriber_base
+    {
+    public:
+        command_write_subscriber(mtsFunctionWrite * function,
+                                 const std::string & topic_name,
+                                 ros::NodeHandle & node_handle,
+                                 const uint32_t queue_size):
+            mFunction(function)
+        {
+            mSubscriber = node_handle.subscribe(topic_name, queue_size,
+                                                &command_write_subscriber::Callback, this);
+        }
+
+        void Callback(const typename _rosType::ConstPtr & message) {
+            mtsROSToCISST(*message, mCISSTData);
+            (*mFunction)(mCISSTData);
+        }
+
+    protected:
+        mtsFunctionWrite * mFunction;
+        _mtsType mCISSTData;
+    };
+
+    /*! Publish the number of commands dropped by a latest command
+      subscriber, see latest_command_write_subscriber. */
+    class latest_command_dropped_publisher: public publisher_base
+    {
+    public:
+        latest_command_dropped_publisher(const latest_command_subscriber_base * subscriber,
+                                         const std::string & topic_name,
+                                         const dvrk_topics_rate::rate rate):
+            publisher_base(topic_name, rate),
+            mSubscriber(subscriber)
+        {}
+
+        void Advertise(ros::NodeHandle & node_handle) {
+            mPublisher = node_handle.advertise<std_msgs::UInt32>(mTopicName, mQueueSize);
+        }
+
+        bool Execute(void) {
+            if (mLazy && (mPublisher.getNumSubscribers() == 0)) {
+                return true;
+            }
+            std_msgs::UInt32::Ptr rosData(new std_msgs::UInt32);
+            rosData->data = mSubscriber->Dropped();
+            mPublisher.publish(rosData);
+            return true;
+        }
+
+    protected:
+        const latest_command_subscriber_base * mSubscriber;
+    };
+
+    /*! ROS bridge used by the dVRK console.  Publishers added with
+      AddPublisherFromCommandRead are grouped in rate classes (see
+      dvrk_topics_rate), each class having its own period.  The bridge
+      period should be the period of the fastest class, classes with
+      a longer period are skipped until they are due so we don't pay
+      for the read, conversion and serialization of topics that don't
+      need to be published as fast as the joint or cartesian states.
+
+      By default, publishers don't read nor convert data when no one
+      has subscribed to their topic, so the bridge's load depends on
+      the topics used, not the topics advertised (see SetLazy).
+
+      Messages are published using shared pointers so subscribers in
+      the same process, e.g. when the console is loaded as a nodelet,
+      don't pay for serialization.
+
+      When spin is set, the bridge doesn't poll using ros::spinOnce.
+      Instead, it waits on the bridges' callback queue (see
+      CallbackQueue) for the remainder of each period and processes
+      callbacks as soon as they are available.  The period is then
+      only used to process the queued commands and events, it
+      doesn't affect the latency.
+
+      All other features of mtsROSBridge (events, subscribers, tf2...)
+      are still available. */
+    class bridge: public mtsROSBridge
+    {
+    public:
+        bridge(const std::string & component_name,
+               const double & period_in_seconds,
+               const bool spin = false,
+               const bool catch_signal = false);
+
+        ~bridge();
+
+        void Startup(void);
+        void Run(void);
+
+        /*! Callback queue shared by all the bridges for subscribers
+          and services, processed by all the bridges created with
+          spin.  The global callback queue is not used so callbacks
+          are not executed by threads outside the bridges, e.g. the
+          nodelet manager's spinner.  To run all callbacks from a
+          single thread, only one bridge should spin (dvrk::console
+          uses a dedicated spin bridge). */
+        static ros::CallbackQueue & CallbackQueue(void);
+
+        /*! Add a publisher using a read command, same as
+          mtsROSBridge::AddPublisherFromCommandRead with a rate
+          class.  If the same command is used for multiple topics
+          (e.g. to support multiple topics versions), the command is
+          read once per cycle and the data is converted for each
+          topic.  All topics for a given command must use the same
+          cisst type. */
+        template <typename _mtsType, typename _rosType>
+        bool AddPublisherFromCommandRead(const std::string & interface_required_name,
+                                         const std::string & function_name,
+                                         const std::string & topic_name,
+                                         const dvrk_topics_rate::rate rate = dvrk_topics_rate::fast,
+                                         const uint32_t queue_size = 1);
+
+        /*! Add a subscriber to a write command, same as
+          mtsROSBridge::AddSubscriberToCommandWrite except that the
+          same command can be used for multiple topics. */
+        template <typename _mtsType, typename _rosType>
+        bool AddSubscriberToCommandWrite(const std::string & interface_required_name,
+                                         const std::string & function_name,
+                                         const std::string & topic_name,
+                                         const uint32_t queue_size = 1);
+
+        /*! Add a publisher for the dvrk_robot::ArmState message, see
+          dvrk::arm_state_publisher.  The required interface should be
+          used only for this publisher, all the functions read from
+          the arm are added to it. */
+        bool AddArmStatePublisher(const std::string & interface_required_name,
+                                  const std::string & topic_name,
+                                  const dvrk_topics_rate::rate rate = dvrk_topics_rate::fast,
+                                  const uint32_t queue_size = 1);
+
+        /*! Add a publisher capturing every sample of an IO arm
+          interface, see dvrk::io_capture_publisher.  Functions are
+          added to the required interface interface_required_name and
+          samples are captured when the event "RunEvent" is received on
+          the required interface interface_required_name + "-run".
+          The latter should be connected to the IO component's
+          "ExecOut" provided interface. */
+        bool AddIOCapturePublisher(const std::string & interface_required_name,
+                                   const std::string & topic_name,
+                                   const size_t samples_per_chunk,
+                                   const size_t buffer_size);
+
+        /*! Add a latched publisher for the joint names of a read
+          command returning a prmStateJoint, see
+          dvrk::joint_state_description_publisher.  This is used with
+          compact joint states (see add_read_compact). */
+        bool AddJointStateDescriptionPublisher(const std::string & interface_required_name,
+                                               const std::string & function_name,
+                                               const std::string & topic_name,
+                                               const dvrk_topics_rate::rate rate = dvrk_topics_rate::slow);
+
+        /*! Add a service returning the Jacobians of an arm on
+          demand, see dvrk::jacobian_service.  The required interface
+          should be used only for this service. */
+        bool AddJacobianService(const std::string & interface_required_name,
+                                const std::string & service_name);
+
+        /*! Add a tf2 frame using a read command returning a
+          prmPositionCartesianGet, replaces
+          mtsROSBridge::Addtf2BroadcasterFromCommandRead.  All frames
+          added to a bridge are published by a single
+          dvrk::tf_publisher, i.e. one message per cycle.  Static
+          frames are published on /tf_static when they move. */
+        bool AddTfPublisher(const std::string & interface_required_name,
+                            const std::string & function_name,
+                            const bool is_static = false);
+
+        /*! Add a subscriber for a write command that only delivers the
+          latest message received, see
+          latest_command_write_subscriber.  This is meant for
+          streaming commands (servo).  Functions are added to the
+          required interface interface_required_name and commands are
+          delivered when the event "RunEvent" is received on the
+          required interface interface_required_name + "-run".  The
+          latter should be connected to the component's "ExecOut"
+          provided interface.  The number of commands dropped is
+          published on topic_name + "/dropped" using the slow rate
+          class. */
+        template <typename _mtsType, typename _rosType>
+        bool AddLatestSubscriberToCommandWrite(const std::string & interface_required_name,
+                                               const std::string & function_name,
+                                               const std::string & topic_name,
+                                               const uint32_t queue_size = 1);
+
+        /*! Periodically publish the latency percentiles for all
+          publishers managed by this bridge (see
+          publisher_base::Latency) on a diagnostic_msgs/DiagnosticArray
+          topic.  Histograms are reset after each publication. */
+        void AddLatencyStatisticsPublisher(const std::string & topic_name,
+                                           const double & period_in_seconds = 1.0);
+
+        /*! Periodically collect and publish the statistics of a
+          timing monitor, see dvrk::timing_statistics_publisher.  The
+          bridge doesn't own the monitor. */
+        void AddTimingStatisticsPublisher(timing_monitor * monitor,
+                                          const std::string & topic_name,
+                                          const double & period_in_seconds = 1.0);
+
+        /*! Set the period for a given rate class.  Periods shorter
+          than the bridge period are effectively the bridge period. */
+        void SetRatePeriod(const dvrk_topics_rate::rate rate,
+                           const double & period_in_seconds);
+
+        double RatePeriod(const dvrk_topics_rate::rate rate) const;
+
+        /*! Change the rate class of all publishers with a topic name
+          matching topic_name.  The name can be either a full topic
+          name or a suffix starting after a "/", both can contain
+          fnmatch wild cards where "*" also matches "/".  For example,
+          "*jacobian*" will match all jacobians for all topics
+          versions (jacobian_body, body/jacobian...) while
+          "PSM1/twist_body_current" will only match PSM1's
+          twist_body_current.  Returns the number of publishers
+          modified. */
+        size_t SetTopicRate(const std::string & topic_name,
+                            const dvrk_topics_rate::rate rate);
+
+        /*! Turn on the "on change" mode for all publishers matching
+          topic_name (see SetTopicRate).  See also
+          publisher_base::SetOnChange. */
+        size_t SetTopicOnChange(const std::string & topic_name,
+                                const double & deadband = 0.0);
+
+        /*! Remove all publishers matching topic_name (see
+          SetTopicRate), e.g. for topics replaced by a service.
+          Returns the number of publishers removed. */
+        size_t RemoveTopics(const std::string & topic_name);
+
+        /*! Turn on or off lazy publishing for all publishers, already
+          added or added later, see publisher_base::SetLazy.  Lazy
+          publishing is on by default. */
+        void SetLazy(const bool lazy);
+
+        /*! Defer the advertisement of topics not in the fast rate
+          class until the bridge starts, i.e. after all components
+          have been created.  This shortens the time spent adding
+          topics before the control components can start.  Must be
+          set before adding publishers. */
+        inline void SetDeferAdvertisement(const bool defer) {
+            mDeferAdvertisement = defer;
+        }
+
+        /*! CPU affinity and priority for the bridge's thread, must be
+          set before the bridge is started. */
+        void SetThreadSettings(const thread_settings & settings);
+
+        /*! Publish when a component has completed its run instead of
+          using the bridge period.  This adds a required interface
+          with an event handler for "RunEvent" which should be
+          connected to the "ExecOut" provided interface of the
+          component (e.g. an arm), see ConnectTrigger.  The event
+          handler is not queued and only raises a signal every
+          decimation events so the component's thread doesn't pay for
+          the conversions.  The bridge thread waits for the signal
+          and publishes as soon as it's raised.  The bridge period is
+          still used to process queued commands and events so it
+          should remain reasonably short. */
+        bool SetTrigger(const std::string & interface_required_name,
+                        const size_t decimation = 1);
+
+        inline bool Triggered(void) const {
+            return mTrigger.Enabled;
+        }
+
+    protected:
+        /*! Topic name matching used by SetTopicRate,
+          SetTopicOnChange and RemoveTopics.  True if the pattern
+          matches the whole topic name or a suffix starting after a
+          "/", pattern can also contain wild cards, e.g.
+          "PSM?/state_joint_current". */
+        static bool TopicMatches(const std::string & topic_name,
+                                 const std::string & pattern);
+
+        /*! Add a publisher to the list of publishers managed by this
+          bridge, the bridge takes ownership of the publisher. */
+        void AddPublisher(publisher_base * publisher);
+
+        /*! Find or create the group of latest command subscribers
+          using a given required interface, returns 0 if the required
+          interfaces can't be created. */
+        latest_command_group * LatestCommandGroup(const std::string & interface_required_name);
+
+        /*! Find or create the read source for a given command, returns
+          0 if the function can't be created or if the command has
+          already been added with a different type. */
+        template <typename _mtsType>
+        command_read_source<_mtsType> * ReadSource(const std::string & interface_required_name,
+                                                   const std::string & function_name);
+
+        /*! Find or create the write function for a given command,
+          returns 0 if the function can't be created. */
+        mtsFunctionWrite * FunctionWrite(const std::string & interface_required_name,
+                                         const std::string & function_name);
+
+        /*! Execute all publishers whose rate class is due. */
+        void Publish(void);
+
+        /*! Publish and reset latency histograms if due. */
+        void PublishLatencyStatistics(const double & now);
+
+        /*! Non queued handler for the triggering component's RunEvent,
+          called from the component's thread. */
+        void TriggerEventHandler(void);
+
+        ros::NodeHandle mNodeHandle;
+        bool mSpin;
+        bool mLazy;
+        bool mDeferAdvertisement;
+        thread_settings mThreadSettings;
+
+        typedef std::list<publisher_base *> PublishersType;
+        PublishersType mPublishers;
+        PublishersType mDeferredPublishers;
+
+        struct RateClass {
+            double Period;
+            double Next;
+            bool Due;
+        };
+        std::vector<RateClass> mRates;
+
+        struct {
+            bool Enabled;
+            double Period;
+            double Next;
+            ros::Publisher Publisher;
+        } mLatencyStatistics;
+
+        // created on first call to AddTfPublisher
+        tf_publisher * mTfPublisher;
+
+        typedef std::map<std::string, latest_command_group *> LatestCommandGroupsType;
+        LatestCommandGroupsType mLatestCommandGroups;
+
+        // read sources and write functions indexed by
+        // "<interface>::<command>"
+        typedef std::map<std::string, command_read_source_base *> ReadSourcesType;
+        ReadSourcesType mReadSources;
+        typedef std::map<std::string, mtsFunctionWrite *> FunctionsWriteType;
+        FunctionsWriteType mFunctionsWrite;
+
+        typedef std::list<command_write_subscriber_base *> SubscribersType;
+        SubscribersType mSubscribers;
+
+        typedef std::list<jacobian_service *> ServicesType;
+        ServicesType mServices;
+
+        struct {
+            bool Enabled;
+            size_t Decimation;
+            size_t Counter;
+            osaThreadSignal Signal;
+        } mTrigger;
+    };
+}
+
+template <typename _mtsType, typename _rosType>
+bool dvrk::bridge::AddPublisherFromCommandRead(const std::string & interface_required_name,
+                                               const std::string & function_name,
+                                               const std::string & topic_name,
+                                               const dvrk_topics_rate::rate rate,
+                                               const uint32_t queue_size)
+{
+    command_read_source<_mtsType> * source =
+        ReadSource<_mtsType>(interface_required_name, function_name);
+    if (!source) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddPublisherFromCommandRead: failed to create function \""
+                                 << function_name << "\" for topic \""
+                                 << topic_name << "\"" << std::endl;
+        return false;
+    }
+    AddPublisher(new command_read_publisher<_mtsType, _rosType>(source, topic_name, rate, queue_size));
+    return true;
+}
+
+template <typename _mtsType, typename _rosType>
+bool dvrk::bridge::AddSubscriberToCommandWrite(const std::string & interface_required_name,
+                                               const std::string & function_name,
+                                               const std::string & topic_name,
+                                               const uint32_t queue_size)
+{
+    mtsFunctionWrite * function = FunctionWrite(interface_required_name, function_name);
+    if (!function) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddSubscriberToCommandWrite: failed to create function \""
+                                 << function_name << "\" for topic \""
+                                 << topic_name << "\"" << std::endl;
+        return false;
+    }
+    mSubscribers.push_back(new command_write_subscriber<_mtsType, _rosType>(function, topic_name,
+                                                                             mNodeHandle, queue_size));
+    return true;
+}
+
+template <typename _mtsType, typename _rosType>
+bool dvrk::bridge::AddLatestSubscriberToCommandWrite(const std::string & interface_required_name,
+                                                     const std::string & function_name,
+                                                     const std::string & topic_name,
+                                                     const uint32_t queue_size)
+{
+    latest_command_group * group = LatestCommandGroup(interface_required_name);
+    if (!group) {
+        return false;
+    }
+    mtsFunctionWrite * function = FunctionWrite(interface_required_name, function_name);
+    if (!function) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddLatestSubscriberToCommandWrite: failed to create function \""
+                                 << function_name << "\" for topic \""
+                                 << topic_name << "\"" << std::endl;
+        return false;
+    }
+    latest_command_write_subscriber<_mtsType, _rosType> * newSubscriber =
+        new latest_command_write_subscriber<_mtsType, _rosType>(function, topic_name,
+                                                                mNodeHandle, queue_size);
+    group->mSubscribers.push_back(newSubscriber);
+    AddPublisher(new latest_command_dropped_publisher(newSubscriber, topic_name + "/dropped",
+                                                      dvrk_topics_rate::slow));
+    return true;
+}
+
+template <typename _mtsType>
+dvrk::command_read_source<_mtsType> *
+dvrk::bridge::ReadSource(const std::string & interface_required_name,
+                         const std::string & function_name)
+{
+    const std::string key = interface_required_name + "::" + function_name;
+    const ReadSourcesType::iterator found = mReadSources.find(key);
+    if (found != mReadSources.end()) {
+        command_read_source<_mtsType> * source =
+            dynamic_cast<command_read_source<_mtsType> *>(found->second);
+        if (!source) {
+            CMN_LOG_CLASS_INIT_ERROR << "ReadSource: command \"" << key
+                                     << "\" already used with a different type" << std::endl;
+        }
+        return source;
+    }
+    // check if the interface exists or try to create one
+    mtsInterfaceRequired * interfaceRequired = this->GetInterfaceRequired(interface_required_name);
+    if (!interfaceRequired) {
+        interfaceRequired = this->AddInterfaceRequired(interface_required_name);
+    }
+    if (!interfaceRequired) {
+        CMN_LOG_CLASS_INIT_ERROR << "ReadSource: failed to create required interface \""
+                                 << interface_required_name << "\"" << std::endl;
+        return 0;
+    }
+    command_read_source<_mtsType> * source = new command_read_source<_mtsType>;
+    if (!interfaceRequired->AddFunction(function_name, source->Function)) {
+        delete source;
+        return 0;
+    }
+    mReadSources[key] = source;
+    return source;
+}
+
+#endif // _dvrk_bridge_h
@@ -0,0 +1,65 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-30
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_compact_joint_state_h
+#define _dvrk_compact_joint_state_h
+
+#include <cisstParameterTypes/prmStateJoint.h>
+
+#include <dvrk_utilities/dvrk_bridge.h>
+#include <dvrk_robot/CompactJointState.h>
+#include <dvrk_robot/CompactJointState32.h>
+#include <dvrk_robot/JointStateDescription.h>
+
+// conversions used by dvrk::command_read_publisher, same signature as
+// cisst_ros_bridge's mtsCISSTToROS.  Conversion fails if the state has
+// more than MAXIMUM_JOINTS joints.
+bool mtsCISSTToROS(const prmStateJoint & cisstData,
+                   dvrk_robot::CompactJointState & rosData,
+                   const std::string & debugInfo);
+
+bool mtsCISSTToROS(const prmStateJoint & cisstData,
+                   dvrk_robot::CompactJointState32 & rosData,
+                   const std::string & debugInfo);
+
+namespace dvrk {
+
+    /*! Publish the joint names of a prmStateJoint on a latched
+      dvrk_robot::JointStateDescription topic, used with the compact
+      joint state messages so names are not sent with every
+      message.  The description is only published when the names
+      change, i.e. usually once. */
+    class joint_state_description_publisher: public publisher_base
+    {
+    public:
+        joint_state_description_publisher(command_read_source<prmStateJoint> * source,
+                                          const std::string & topic_name,
+                                          const dvrk_topics_rate::rate rate);
+
+        void Advertise(ros::NodeHandle & node_handle);
+
+        bool Execute(void);
+
+    protected:
+        command_read_source<prmStateJoint> * mSource;
+        bool mFirst;
+        std::vector<std::string> mNames;
+    };
+}
+
+#endif // _dvrk_compact_joint_state_h
@@ -20,27 +20,129 @@ http://www.cisst.org/cisst/license.txt.
 #define _dvrk_console_h
 
 #include <dvrk_utilities/dvrk_add_topics_functions.h>
+#include <dvrk_utilities/dvrk_startup_profiler.h>
+#include <dvrk_utilities/dvrk_thread_settings.h>
+
+#include <set>
 
 class mtsIntuitiveResearchKitConsole;
 
+namespace dvrk {
+    class shared_state_writer;
+    class timing_monitor;
+    class thread_configurator;
+}
+
 namespace dvrk {
     class console
     {
     public:
+        /*! Create all ROS bridges and add the topics for all the
+          components of the dVRK console.  If bridge_per_arm is set,
+          each arm's topics are published using a separate bridge,
+          i.e. a separate thread.  If defer_advertisement is set,
+          topics not published at the fast rate are advertised when
+          the bridges start (see dvrk::bridge::SetDeferAdvertisement).
+          Multiple topics versions can be used at once, data read
+          from the arms is shared by all versions. */
         console(const double & publish_rate_in_seconds,
                 const double & tf_rate_in_seconds,
                 const std::string & ros_namespace,
                 mtsIntuitiveResearchKitConsole * mts_console,
-                const dvrk_topics_version::version version);
+                const dvrk::topics_versions & versions,
+                const bool bridge_per_arm = false,
+                const bool defer_advertisement = false);
+        /*! Configure the ROS bridges using a JSON file.  Supported
+          fields are:
+          - lazy-publishing: if true (default), topics without
+            subscribers are not published, false publishes all topics
+          - publish-periods: period of each rate class (see
+            dvrk_topics_rate), e.g. {"medium": 0.05, "slow": 0.5}
+          - topic-rates: rate class of some topics, e.g.
+            {"*jacobian*": "fast"}, see dvrk::bridge::SetTopicRate
+            for topic name matching
+          - topic-on-change: only publish some topics when their value
+            changes, the value is the deadband (0 to compare
+            timestamps only), e.g. {"SUJ*": 0.001}
+          - topic-disabled: list of topics to remove, e.g.
+            ["*jacobian*"] if clients use the query_jacobian service
+          - timing-statistics: "overrun-ratio" and "log-period" of the
+            timing histograms (see dvrk::timing_monitor)
+          - io-interfaces: list of arms ("name" and "period") to add IO
+            level topics for, with an optional "capture" to publish
+            all the IO samples in chunks (see
+            dvrk::io_capture_publisher)
+          - recorder: record the arms' state on every arm cycle in
+            memory mapped files ("file-prefix", "duration" and "arms",
+            see dvrk::state_recorder)
+          - shared-memory: export the arms' latest state for local
+            clients ("name" and "arms", see dvrk::shared_state_writer)
+          - bridges: thread settings (see dvrk::thread_settings) per
+            bridge name, e.g. {"spin": {"cpus": [3], "priority": 80}}
+          - threads: thread settings per component class (see
+            SetThreadSettings)
+          - lock-memory: lock all pages in memory if true
+          - publish-on-arm-event: publish an arm's topics right after
+            the arm has run, the value is the decimation (requires one
+            bridge per arm) */
         void Configure(const std::string & jsonFile);
         void Connect(void);
+
+        /*! Thread settings (CPU affinity, policy, priority or nice)
+          for a class of components, "io", "arms", "teleop" or
+          "bridges".  Settings for IO, arms and teleops are applied
+          on the component's first run, bridges apply them when they
+          start.  Bridges with their own settings ("bridges" in
+          Configure) are not affected.  Must be called before
+          Connect, returns false if the class doesn't exist. */
+        bool SetThreadSettings(const std::string & component_class,
+                               const dvrk::thread_settings & settings);
+
+        /*! Print the requested and effective thread settings of all
+          components, must be called after the components have
+          started.  Returns false if some settings couldn't be
+          applied. */
+        bool ReportThreadSettings(std::ostream & output_stream) const;
+
+        /*! Time spent adding topics and connecting the bridges, can
+          also be used to profile other startup steps. */
+        inline dvrk::startup_profiler & Profiler(void) {
+            return mProfiler;
+        }
+
     protected:
+        /*! Name of the bridge used for a given arm's topics, either the
+          arm's bridge or the main publish bridge. */
+        const std::string & ArmBridgeName(const std::string & arm_name) const;
+
+        /*! All bridges, indexed by role (i.e. "publishers",
+          "tf_broadcast", "spin", "stats"), arm name if the console
+          uses one bridge per arm and "<arm>/io" for IO bridges. */
+        typedef std::map<std::string, dvrk::bridge *> BridgesType;
+        BridgesType mBridges;
         std::string mBridgeName;
         std::string mTfBridgeName;
         std::string mNameSpace;
         mtsIntuitiveResearchKitConsole * mConsole;
-        dvrk_topics_version::version mVersion;
+        dvrk::topics_versions mVersions;
         std::list<std::string> mIOInterfaces;
+        std::list<std::string> mIOCaptures;
+        /*! State recorder component name for each arm recorded. */
+        typedef std::map<std::string, std::string> RecordersType;
+        RecordersType mRecorders;
+        bool mDeferAdvertisement;
+        dvrk::shared_state_writer * mSharedState;
+        std::list<std::string> mSharedStateArms;
+        /*! Timing histograms for all periodic tasks, tasks are added
+          in Connect. */
+        dvrk::timing_monitor * mTimingMonitor;
+        /*! Thread settings per component class, bridges with their
+          own settings and component applying them. */
+        typedef std::map<std::string, dvrk::thread_settings> ThreadSettingsType;
+        ThreadSettingsType mThreadSettings;
+        std::set<std::string> mBridgesWithThreadSettings;
+        dvrk::thread_configurator * mThreadConfigurator;
+        dvrk::startup_profiler mProfiler;
     };
 }
 
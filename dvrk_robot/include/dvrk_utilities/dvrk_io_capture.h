@@ -0,0 +1,93 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-22
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_io_capture_h
+#define _dvrk_io_capture_h
+
+#include <atomic>
+#include <vector>
+
+#include <cisstParameterTypes/prmPositionJointGet.h>
+
+#include <dvrk_utilities/dvrk_bridge.h>
+#include <dvrk_robot/IOSamples.h>
+
+namespace dvrk {
+
+    /*! Publisher capturing every IO sample for an arm.  The IO
+      component's "RunEvent" is handled without queueing, i.e. in the
+      IO thread, and the joint, actuator and potentiometer positions
+      are copied in a single producer, single consumer ring buffer.
+      The bridge then publishes all the samples buffered in chunks of
+      SamplesPerChunk samples (dvrk_robot::IOSamples) so clients get
+      lossless data at the IO rate without one message per sample.
+
+      When lazy (default) and there is no subscriber, the event
+      handler returns immediately so the IO thread doesn't pay for
+      the capture.  The buffer's vectors are sized on the first pass
+      through the buffer. */
+    class io_capture_publisher: public publisher_base
+    {
+    public:
+        io_capture_publisher(const std::string & topic_name,
+                             const size_t samples_per_chunk,
+                             const size_t buffer_size);
+
+        void Advertise(ros::NodeHandle & node_handle);
+
+        /*! Add the read functions to the required interface connected
+          to the IO arm interface and the event handler to the
+          required interface connected to the IO "ExecOut"
+          interface. */
+        bool AddFunctions(mtsInterfaceRequired * interface_required,
+                          mtsInterfaceRequired * run_interface_required);
+
+        bool Execute(void);
+
+        /*! Non queued handler for the IO's RunEvent, called from the
+          IO thread. */
+        void RunEventHandler(void);
+
+    protected:
+        struct Sample {
+            double Timestamp;
+            vctDoubleVec JointPosition;
+            vctDoubleVec ActuatorPosition;
+            vctDoubleVec PotentiometerPosition;
+        };
+
+        size_t mSamplesPerChunk;
+        std::vector<Sample> mBuffer;
+        // next sample to write, only modified by the IO thread
+        std::atomic<size_t> mHead;
+        // next sample to read, only modified by the bridge thread
+        std::atomic<size_t> mTail;
+        std::atomic<bool> mActive;
+        std::atomic<uint32_t> mDropped;
+
+        struct {
+            mtsFunctionRead GetPosition;
+            mtsFunctionRead GetPositionActuator;
+            mtsFunctionRead GetAnalogInputPosSI;
+        } IO;
+
+        prmPositionJointGet mActuatorPosition;
+    };
+}
+
+#endif // _dvrk_io_capture_h
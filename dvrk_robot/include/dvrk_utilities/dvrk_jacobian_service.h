@@ -0,0 +1,75 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-31
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_jacobian_service_h
+#define _dvrk_jacobian_service_h
+
+#include <cisstVector/vctDynamicVectorTypes.h>
+#include <cisstVector/vctDynamicMatrixTypes.h>
+#include <cisstMultiTask/mtsFunctionRead.h>
+#include <cisstMultiTask/mtsFunctionQualifiedRead.h>
+#include <cisstMultiTask/mtsInterfaceRequired.h>
+
+#include <ros/ros.h>
+#include <dvrk_robot/QueryJacobian.h>
+
+namespace dvrk {
+
+    /*! ROS service returning an arm's Jacobians on demand
+      (dvrk_robot/QueryJacobian), so clients who only need a
+      Jacobian occasionally don't need the Jacobian topics.  Without
+      joint positions in the request, the service returns the
+      Jacobians for the arm's latest state (GetJacobianBody and
+      GetJacobianSpatial).  With joint positions, it uses the arm's
+      qualified read commands ComputeJacobianBody and
+      ComputeJacobianSpatial, these are optional and the service
+      fails if the arm doesn't provide them.  The service is
+      advertised on dvrk::bridge::CallbackQueue so the callback is
+      called by the spinning bridges, i.e. the spin bridge's thread
+      for dvrk::console. */
+    class jacobian_service
+    {
+    public:
+        jacobian_service(const std::string & service_name);
+
+        /*! Add all the functions used by the service to the required
+          interface. */
+        bool AddFunctions(mtsInterfaceRequired * interface_required);
+
+        void Advertise(ros::NodeHandle & node_handle);
+
+        bool Callback(dvrk_robot::QueryJacobian::Request & request,
+                      dvrk_robot::QueryJacobian::Response & response);
+
+    protected:
+        std::string mServiceName;
+        ros::ServiceServer mServer;
+
+        struct {
+            mtsFunctionRead GetJacobianBody;
+            mtsFunctionRead GetJacobianSpatial;
+            mtsFunctionQualifiedRead ComputeJacobianBody;
+            mtsFunctionQualifiedRead ComputeJacobianSpatial;
+        } Arm;
+
+        vctDoubleVec mPosition;
+        vctDoubleMat mBodyJacobian, mSpatialJacobian;
+    };
+}
+
+#endif // _dvrk_jacobian_service_h
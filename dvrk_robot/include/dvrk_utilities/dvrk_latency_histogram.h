@@ -0,0 +1,68 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-20
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_latency_histogram_h
+#define _dvrk_latency_histogram_h
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+namespace dvrk {
+
+    /*! Histogram of latencies with logarithmic bins, from 1 micro
+      second to about 1 second with 8 bins per octave, i.e. about 9%
+      resolution.  Adding a sample doesn't allocate memory so this
+      can be used on every publication. */
+    class latency_histogram
+    {
+    public:
+        latency_histogram(void);
+
+        /*! Add a sample, in seconds.  Negative values are ignored. */
+        void Add(const double & latency_in_seconds);
+
+        /*! Add all the samples of another histogram. */
+        void Merge(const latency_histogram & other);
+
+        void Reset(void);
+
+        inline size_t Count(void) const {
+            return mCount;
+        }
+
+        inline double Max(void) const {
+            return mMax;
+        }
+
+        /*! Upper bound of the bin containing the given percentile
+          (between 0 and 1), 0 if the histogram is empty. */
+        double Percentile(const double & percentile) const;
+
+        enum {BinsPerOctave = 8, NumberOfOctaves = 20};
+
+    protected:
+        static double UpperBound(const size_t bin);
+
+        std::vector<uint32_t> mBins;
+        size_t mCount;
+        double mMax;
+    };
+}
+
+#endif // _dvrk_latency_histogram_h
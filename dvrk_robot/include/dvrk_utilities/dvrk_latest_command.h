@@ -0,0 +1,189 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-17
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_latest_command_h
+#define _dvrk_latest_command_h
+
+#include <atomic>
+#include <list>
+
+#include <cisstMultiTask/mtsFunctionWrite.h>
+#include <cisst_ros_bridge/mtsCISSTToROS.h>
+
+#include <ros/ros.h>
+
+namespace dvrk {
+
+    /*! Single value slot shared between one writer and one reader
+      thread (triple buffer).  The writer always overwrites the
+      latest value and the reader always gets the latest value
+      written, neither of them ever blocks. */
+    template <typename _type>
+    class latest_slot
+    {
+    public:
+        latest_slot(void):
+            mBack(0),
+            mMiddle(1),
+            mFront(2)
+        {}
+
+        /*! Buffer the writer can fill before calling Commit. */
+        inline _type & Back(void) {
+            return mBuffers[mBack];
+        }
+
+        /*! Make the back buffer available to the reader.  Returns
+          true if the previous value had not been read yet, i.e. it
+          has been dropped. */
+        inline bool Commit(void) {
+            const unsigned int previous = mMiddle.exchange(mBack | Fresh);
+            mBack = previous & Index;
+            return (previous & Fresh);
+        }
+
+        /*! Get the latest value committed, returns false if no new
+          value has been committed since the last update. */
+        inline bool Update(void) {
+            if (!(mMiddle.load() & Fresh)) {
+                return false;
+            }
+            mFront = mMiddle.exchange(mFront) & Index;
+            return true;
+        }
+
+        /*! Latest value read by Update. */
+        inline const _type & Front(void) const {
+            return mBuffers[mFront];
+        }
+
+    protected:
+        enum {Index = 3, Fresh = 4};
+        _type mBuffers[3];
+        unsigned int mBack;
+        std::atomic<unsigned int> mMiddle;
+        unsigned int mFront;
+    };
+
+    /*! Base class for subscribers delivering only the latest command
+      received, see latest_command_write_subscriber. */
+    class latest_command_subscriber_base
+    {
+    public:
+        latest_command_subscriber_base(const std::string & topic_name):
+            mTopicName(topic_name),
+            mDropped(0)
+        {}
+
+        virtual ~latest_command_subscriber_base() {}
+
+        /*! Send the latest command received to the cisst component,
+          if any. */
+        virtual void Deliver(void) = 0;
+
+        inline const std::string & TopicName(void) const {
+            return mTopicName;
+        }
+
+        /*! Number of commands received but overwritten before they
+          were delivered. */
+        inline uint32_t Dropped(void) const {
+            return mDropped.load();
+        }
+
+    protected:
+        std::string mTopicName;
+        std::atomic<uint32_t> mDropped;
+        ros::Subscriber mSubscriber;
+    };
+
+    /*! Equivalent of mtsROSSubscriberWrite where messages are not
+      queued.  The write function is owned by the bridge.  The ROS
+      callback converts the message and overwrites the latest command,
+      the command is delivered to the cisst component by Deliver (see
+      latest_command_group).  This prevents stale setpoints from being
+      applied one after another if a client bursts or the spin thread
+      stalls. */
+    template <typename _mtsType, typename _rosType>
+    class latest_command_write_subscriber: public latest_command_subscriber_base
+    {
+    public:
+        latest_command_write_subscriber(mtsFunctionWrite * function,
+                                        const std::string & topic_name,
+                                        ros::NodeHandle & node_handle,
+                                        const uint32_t queue_size):
+            latest_command_subscriber_base(topic_name),
+            mFunction(function)
+        {
+            mSubscriber = node_handle.subscribe(topic_name, queue_size,
+                                                &latest_command_write_subscriber::Callback, this);
+        }
+
+        void Callback(const typename _rosType::ConstPtr & message) {
+            mtsROSToCISST(*message, mSlot.Back());
+            if (mSlot.Commit()) {
+                ++mDropped;
+            }
+        }
+
+        void Deliver(void) {
+            if (mSlot.Update()) {
+                (*mFunction)(mSlot.Front());
+            }
+        }
+
+    protected:
+        mtsFunctionWrite * mFunction;
+        latest_slot<_mtsType> mSlot;
+    };
+
+    /*! Group of latest command subscribers for a cisst component.
+      Commands are delivered when the component's "RunEvent" is
+      received so at most one command per topic is queued for each
+      run of the component. */
+    class latest_command_group
+    {
+    public:
+        ~latest_command_group() {
+            const SubscribersType::iterator end = mSubscribers.end();
+            SubscribersType::iterator iter;
+            for (iter = mSubscribers.begin();
+                 iter != end;
+                 ++iter) {
+                delete *iter;
+            }
+        }
+
+        /*! Non queued event handler, called from the component's
+          thread. */
+        void RunEventHandler(void) {
+            const SubscribersType::iterator end = mSubscribers.end();
+            SubscribersType::iterator iter;
+            for (iter = mSubscribers.begin();
+                 iter != end;
+                 ++iter) {
+                (*iter)->Deliver();
+            }
+        }
+
+        typedef std::list<latest_command_subscriber_base *> SubscribersType;
+        SubscribersType mSubscribers;
+    };
+}
+
+#endif // _dvrk_latest_command_h
@@ -0,0 +1,114 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-06
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_sample_compare_h
+#define _dvrk_sample_compare_h
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include <cisstVector/vctDynamicVectorTypes.h>
+#include <cisstMultiTask/mtsGenericObject.h>
+#include <cisstParameterTypes/prmStateJoint.h>
+#include <cisstParameterTypes/prmPositionJointGet.h>
+#include <cisstParameterTypes/prmPositionCartesianGet.h>
+
+// Helpers used by the dvrk::bridge publishers in "on change" mode
+
+namespace dvrk {
+
+    /*! Timestamp of a sample read from a cisst command.  Only types
+      derived from mtsGenericObject carry a timestamp, for all other
+      types 0 is returned so the sample is always considered new. */
+    template <typename _type>
+    typename std::enable_if<std::is_base_of<mtsGenericObject, _type>::value, double>::type
+    sample_timestamp(const _type & sample) {
+        return sample.Timestamp();
+    }
+
+    template <typename _type>
+    typename std::enable_if<!std::is_base_of<mtsGenericObject, _type>::value, double>::type
+    sample_timestamp(const _type & CMN_UNUSED(sample)) {
+        return 0.0;
+    }
+
+    /*! Validity of a sample, types not derived from mtsGenericObject
+      are always valid. */
+    template <typename _type>
+    typename std::enable_if<std::is_base_of<mtsGenericObject, _type>::value, bool>::type
+    sample_valid(const _type & sample) {
+        return sample.Valid();
+    }
+
+    template <typename _type>
+    typename std::enable_if<!std::is_base_of<mtsGenericObject, _type>::value, bool>::type
+    sample_valid(const _type & CMN_UNUSED(sample)) {
+        return true;
+    }
+
+    /*! Distance between two samples used for the deadband.  The
+      default implementation returns infinity, i.e. types without a
+      specialized distance are always published. */
+    template <typename _type>
+    inline double sample_distance(const _type & CMN_UNUSED(current),
+                                  const _type & CMN_UNUSED(previous)) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    /*! Largest absolute difference between elements. */
+    inline double sample_distance(const vctDoubleVec & current,
+                                  const vctDoubleVec & previous) {
+        if (current.size() != previous.size()) {
+            return std::numeric_limits<double>::infinity();
+        }
+        return (current - previous).MaxAbsElement();
+    }
+
+    /*! Largest absolute difference between joint positions. */
+    inline double sample_distance(const prmStateJoint & current,
+                                  const prmStateJoint & previous) {
+        return sample_distance(current.Position(), previous.Position());
+    }
+
+    inline double sample_distance(const prmPositionJointGet & current,
+                                  const prmPositionJointGet & previous) {
+        return sample_distance(current.Position(), previous.Position());
+    }
+
+    /*! Largest of the translation distance (in meters) and the angle
+      of the rotation between both orientations (in radians). */
+    inline double sample_distance(const prmPositionCartesianGet & current,
+                                  const prmPositionCartesianGet & previous) {
+        const double translation =
+            (current.Position().Translation() - previous.Position().Translation()).Norm();
+        // trace of R1^T * R2 is the sum of element wise products
+        double trace = 0.0;
+        for (size_t row = 0; row < 3; ++row) {
+            for (size_t col = 0; col < 3; ++col) {
+                trace +=
+                    current.Position().Rotation().Element(row, col)
+                    * previous.Position().Rotation().Element(row, col);
+            }
+        }
+        const double cosAngle = std::max(-1.0, std::min(1.0, 0.5 * (trace - 1.0)));
+        return std::max(translation, std::acos(cosAngle));
+    }
+}
+
+#endif // _dvrk_sample_compare_h
@@ -0,0 +1,89 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-24
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_shared_state_h
+#define _dvrk_shared_state_h
+
+/* This file must compile as C, it is the only header needed by
+   clients of the dvrk_shared_state library (e.g. using ctypes in
+   Python or loadlibrary in Matlab) */
+
+#include <dvrk_utilities/dvrk_arm_state.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DVRK_SHARED_STATE_VERSION 1
+#define DVRK_SHARED_STATE_MAXIMUM_ARMS 16
+#define DVRK_SHARED_STATE_DEFAULT_NAME "/dvrk_state"
+
+/*! Header at the beginning of the shared memory segment.  The writer
+  sets NumberOfArms once all the slots are initialized. */
+typedef struct {
+    char Magic[8]; /* "DVRKSHM" */
+    uint32_t Version;
+    uint32_t SlotSize;
+    uint32_t NumberOfArms;
+    uint32_t Reserved;
+} dvrk_shared_state_header;
+
+/*! Latest state of an arm, protected by a seqlock.  Sequence is odd
+  while the writer updates State.  Slots are aligned on cache lines so
+  writers for different arms don't share cache lines. */
+typedef struct {
+    char Name[32];
+    uint32_t Sequence;
+    uint32_t Reserved;
+    dvrk_arm_state State;
+} __attribute__((aligned(64))) dvrk_shared_state_slot;
+
+/*! Opaque reader handle. */
+typedef struct dvrk_shared_state_reader dvrk_shared_state_reader;
+
+/*! Map an existing segment created by the dVRK console (see
+  "shared-memory" in dvrk_console_json's -i file).  Returns 0 (null)
+  if the segment doesn't exist or is not compatible. */
+dvrk_shared_state_reader * dvrk_shared_state_open(const char * segment_name);
+
+void dvrk_shared_state_close(dvrk_shared_state_reader * reader);
+
+int dvrk_shared_state_number_of_arms(const dvrk_shared_state_reader * reader);
+
+/*! Name of the arm for a given index, 0 (null) if the index is
+  invalid. */
+const char * dvrk_shared_state_arm_name(const dvrk_shared_state_reader * reader,
+                                        const int index);
+
+/*! Index of an arm by name, -1 if not found. */
+int dvrk_shared_state_find_arm(const dvrk_shared_state_reader * reader,
+                               const char * arm_name);
+
+/*! Copy a consistent snapshot of an arm's latest state.  Returns 0 on
+  success, -1 if the index is invalid or the writer kept updating the
+  state during all the attempts (e.g. the console stopped while
+  writing). */
+int dvrk_shared_state_read(const dvrk_shared_state_reader * reader,
+                           const int index,
+                           dvrk_arm_state * state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _dvrk_shared_state_h */
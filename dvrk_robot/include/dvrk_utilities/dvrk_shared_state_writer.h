@@ -0,0 +1,94 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-24
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_shared_state_writer_h
+#define _dvrk_shared_state_writer_h
+
+#include <atomic>
+#include <list>
+
+#include <cisstMultiTask/mtsComponent.h>
+
+#include <dvrk_utilities/dvrk_arm_state_sampler.h>
+#include <dvrk_utilities/dvrk_shared_state.h>
+
+namespace dvrk {
+
+    /*! Component exporting the latest state of some arms in a POSIX
+      shared memory segment, see dvrk_shared_state.h for the layout
+      and the reader library.  Each arm's state is written from a
+      non queued handler for the arm's "RunEvent", i.e. in the arm
+      thread, and protected by a seqlock so readers never block the
+      arm and get a consistent snapshot.  For each arm added, the
+      required interface arm_name must be connected to the arm's
+      provided interface and arm_name + "-run" to the arm's "ExecOut"
+      interface.  The segment is created when the component starts
+      and removed when it stops. */
+    class shared_state_writer: public mtsComponent
+    {
+    public:
+        shared_state_writer(const std::string & component_name,
+                            const std::string & segment_name);
+
+        ~shared_state_writer();
+
+        /*! Must be called before the component starts, returns false
+          if the arm can't be added. */
+        bool AddArm(const std::string & arm_name);
+
+        void Startup(void);
+        void Cleanup(void);
+
+        inline const std::string & SegmentName(void) const {
+            return mSegmentName;
+        }
+
+    protected:
+        bool Open(void);
+        void Close(void);
+
+        class arm_slot
+        {
+        public:
+            arm_slot(shared_state_writer * writer):
+                Writer(writer),
+                Slot(0)
+            {}
+            /*! Non queued handler for the arm's RunEvent, called from
+              the arm thread. */
+            void RunEventHandler(void);
+
+            std::string Name;
+            shared_state_writer * Writer;
+            dvrk_shared_state_slot * Slot;
+            arm_state_sampler Sampler;
+            dvrk_arm_state State;
+        };
+
+        std::string mSegmentName;
+        std::list<arm_slot *> mArms;
+        size_t mSize;
+        void * mMemory;
+        // handshake with the arm threads so the segment is not
+        // unmapped while a state is being written
+        std::atomic<bool> mExporting;
+        std::atomic<size_t> mWriters;
+    };
+}
+
+#endif // _dvrk_shared_state_writer_h
@@ -0,0 +1,55 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-21
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_startup_profiler_h
+#define _dvrk_startup_profiler_h
+
+#include <iostream>
+#include <list>
+#include <string>
+
+namespace dvrk {
+
+    /*! Measure the wall time spent in each startup step, e.g. adding
+      topics or connecting bridges.  Steps are sequential, starting
+      a new step ends the current one. */
+    class startup_profiler
+    {
+    public:
+        startup_profiler(void);
+
+        void Begin(const std::string & step);
+        void End(void);
+
+        /*! Print all steps in order with their duration in
+          milliseconds as well as the total. */
+        void Report(std::ostream & output) const;
+
+    protected:
+        struct Step {
+            std::string Name;
+            double Duration;
+        };
+        std::list<Step> mSteps;
+        Step mCurrent;
+        double mStart;
+        bool mRunning;
+    };
+}
+
+#endif // _dvrk_startup_profiler_h
@@ -0,0 +1,110 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-23
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_state_recorder_h
+#define _dvrk_state_recorder_h
+
+#include <stdint.h>
+#include <atomic>
+
+#include <cisstMultiTask/mtsComponent.h>
+
+#include <dvrk_utilities/dvrk_arm_state_sampler.h>
+
+namespace dvrk {
+
+    /*! Maximum number of joints in a state record, records have a
+      fixed size so unused joints are set to 0. */
+    const size_t state_record_maximum_joints = DVRK_ARM_STATE_MAXIMUM_JOINTS;
+
+    /*! Version of the file format, must be incremented if
+      state_record_file_header or state_record change. */
+    const uint32_t state_record_version = 1;
+
+    /*! Header at the beginning of each state recorder file.  The
+      number of records is updated after each record so a file can be
+      read while recording or after a crash. */
+    struct state_record_file_header {
+        char Magic[8]; // "DVRKREC"
+        uint32_t Version;
+        uint32_t RecordSize;
+        uint64_t Capacity;
+        uint64_t NumberOfRecords;
+        // records lost because the file was full
+        uint64_t NumberOfDropped;
+        double Period;
+        char Name[64];
+    };
+
+    /*! Arm state recorded on each arm cycle. */
+    typedef dvrk_arm_state state_record;
+
+    /*! Component recording an arm's state in a memory mapped file.
+      The state is read and appended to the file from a non queued
+      handler for the arm's "RunEvent", i.e. in the arm thread, right
+      after the arm has computed its new state so there is one record
+      per arm cycle.  The file is preallocated for capacity records
+      when the component starts and truncated to the number of records
+      when it stops.  Once the file is full, new records are dropped
+      and counted.  The required interface "Arm" must be connected to
+      the arm's provided interface and "Run" to the arm's "ExecOut"
+      interface.  Files can be converted or replayed using
+      dvrk_state_recorder_convert. */
+    class state_recorder: public mtsComponent
+    {
+    public:
+        state_recorder(const std::string & component_name,
+                       const std::string & file_name,
+                       const size_t capacity,
+                       const double & period_in_seconds);
+
+        ~state_recorder();
+
+        void Startup(void);
+        void Cleanup(void);
+
+        inline const std::string & FileName(void) const {
+            return mFileName;
+        }
+
+    protected:
+        bool Open(void);
+        void Close(void);
+
+        /*! Non queued handler for the arm's RunEvent, called from the
+          arm thread. */
+        void RunEventHandler(void);
+
+        std::string mFileName;
+        size_t mCapacity;
+        double mPeriod;
+        int mFileDescriptor;
+        size_t mFileSize;
+        void * mMemory;
+        state_record_file_header * mHeader;
+        state_record * mRecords;
+        // handshake with the arm thread so the file is not unmapped
+        // while a record is being written
+        std::atomic<bool> mRecording;
+        std::atomic<bool> mWriting;
+
+        arm_state_sampler mSampler;
+    };
+}
+
+#endif // _dvrk_state_recorder_h
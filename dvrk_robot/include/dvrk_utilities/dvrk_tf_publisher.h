@@ -0,0 +1,81 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-29
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_tf_publisher_h
+#define _dvrk_tf_publisher_h
+
+#include <cisstParameterTypes/prmPositionCartesianGet.h>
+
+#include <dvrk_utilities/dvrk_bridge.h>
+#include <tf2_msgs/TFMessage.h>
+
+namespace dvrk {
+
+    /*! Publisher for all the tf2 frames of a bridge, replaces one
+      mtsROSBridge tf2 broadcaster per frame.
+
+      Dynamic frames (e.g. arms' measured_cp) are gathered in a single
+      tf2_msgs/TFMessage per cycle on /tf.  Frames whose sample has
+      not changed since the last publication (same timestamp, e.g. arm
+      not running) are not published again.
+
+      Static frames (e.g. base frames of arms mounted on the SUJs) are
+      published on /tf_static, latched, only when they have moved by
+      more than the deadband (see dvrk::sample_distance).  Each
+      publication contains all static frames since latched topics only
+      keep the last message.  Listeners store these frames without
+      history so they should only be used for frames that rarely
+      move. */
+    class tf_publisher: public publisher_base
+    {
+    public:
+        tf_publisher(const dvrk_topics_rate::rate rate);
+
+        void Advertise(ros::NodeHandle & node_handle);
+
+        /*! Add a frame read from source, the source can be shared
+          with other publishers (see bridge::ReadSource).  The frame
+          names are the reference and moving frames of the sample. */
+        void AddFrame(command_read_source<prmPositionCartesianGet> * source,
+                      const bool is_static);
+
+        bool Execute(void);
+
+        /*! Minimum motion to republish static frames, default is
+          0.1 mm or 0.1 mrad. */
+        inline void SetStaticDeadband(const double & deadband) {
+            mStaticDeadband = deadband;
+        }
+
+    protected:
+        struct frame {
+            command_read_source<prmPositionCartesianGet> * Source;
+            bool Static;
+            bool First;
+            prmPositionCartesianGet LastPublished;
+            geometry_msgs::TransformStamped Transform;
+        };
+
+        typedef std::vector<frame> FramesType;
+        FramesType mFrames;
+        double mStaticDeadband;
+        ros::Publisher mStaticPublisher;
+    };
+}
+
+#endif // _dvrk_tf_publisher_h
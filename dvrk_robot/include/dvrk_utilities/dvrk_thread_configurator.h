@@ -0,0 +1,86 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-06-04
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_thread_configurator_h
+#define _dvrk_thread_configurator_h
+
+#include <atomic>
+#include <list>
+#include <iostream>
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstMultiTask/mtsComponent.h>
+
+#include <dvrk_utilities/dvrk_thread_settings.h>
+
+namespace dvrk {
+
+    /*! Component applying thread settings (see dvrk::thread_settings)
+      to the threads of components we can't modify, e.g. IO, arms
+      and teleoperations.  For each task added, the required
+      interface task_name + "-run" must be connected to the task's
+      "ExecOut" interface.  Settings are applied from a non queued
+      handler for the task's "RunEvent" on its first run, i.e. in the
+      task's thread.  The effective settings of the thread are then
+      recorded so they can be reported, this can also be used for
+      tasks which apply their own settings (e.g. dvrk::bridge). */
+    class thread_configurator: public mtsComponent
+    {
+    public:
+        thread_configurator(const std::string & component_name);
+
+        ~thread_configurator();
+
+        /*! Must be called before the component starts.  If apply is
+          false, the settings are not applied but the effective
+          settings are still recorded. */
+        bool AddTask(const std::string & task_name,
+                     const thread_settings & settings,
+                     const bool apply = true);
+
+        /*! Print the requested and effective settings for all
+          tasks, waits up to timeout for tasks which haven't run
+          yet.  Returns false if some settings couldn't be applied. */
+        bool Report(std::ostream & output_stream,
+                    const double & timeout_in_seconds = 1.0 * cmn_s) const;
+
+    protected:
+        class task
+        {
+        public:
+            task(void);
+
+            /*! Non queued handler for the task's RunEvent, called from
+              the task's thread. */
+            void RunEventHandler(void);
+
+            std::string Name;
+            thread_settings Settings;
+            bool Apply;
+            bool Applied;
+            std::string Message;
+            std::string Effective;
+            std::atomic<bool> Done;
+        };
+
+        typedef std::list<task *> TasksType;
+        TasksType mTasks;
+    };
+}
+
+#endif // _dvrk_thread_configurator_h
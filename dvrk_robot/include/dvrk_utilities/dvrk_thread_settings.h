@@ -0,0 +1,96 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-08
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_thread_settings_h
+#define _dvrk_thread_settings_h
+
+#include <string>
+#include <vector>
+
+namespace Json {
+    class Value;
+}
+
+namespace dvrk {
+
+    /*! CPU affinity, scheduling policy and priority for a thread.
+      Default values leave the thread as created by the OS. */
+    struct thread_settings
+    {
+        typedef enum {POLICY_UNCHANGED, POLICY_OTHER, POLICY_FIFO} policy;
+
+        thread_settings(void):
+            Policy(POLICY_UNCHANGED),
+            Priority(0),
+            SetNice(false),
+            Nice(0)
+        {}
+
+        /*! CPUs the thread is allowed to run on, all if empty. */
+        std::vector<int> CPUs;
+
+        /*! Scheduling policy, if unchanged the thread uses SCHED_FIFO
+          when Priority is greater than 0. */
+        policy Policy;
+
+        /*! Real-time priority, only used with SCHED_FIFO. */
+        int Priority;
+
+        /*! Nice value, only used with SCHED_OTHER. */
+        bool SetNice;
+        int Nice;
+
+        /*! True if all settings are default, i.e. nothing to apply. */
+        bool IsDefault(void) const;
+
+        /*! Settings from JSON, e.g. {"cpus": [2, 3], "priority": 80}
+          or {"policy": "other", "nice": -5}.  "cpus" can also be a
+          single integer and "policy" is either "fifo" or "other".
+          Returns false if the JSON value is not valid, including CPU
+          indices outside 0 to CPU_SETSIZE - 1. */
+        bool FromJSON(const Json::Value & json_value);
+
+        /*! Settings from a string, used for command line options.
+          Format is policy[:value][@cpus] where value is the priority
+          for "fifo" or the nice value for "other" and cpus is a comma
+          separated list, e.g. "fifo:80@2,3", "other:-5" or "@0".
+          Returns false if the string is not valid, including CPU
+          indices outside 0 to CPU_SETSIZE - 1. */
+        bool FromString(const std::string & settings);
+
+        std::string HumanReadable(void) const;
+    };
+
+    /*! Apply settings to the calling thread.  Returns false if one of
+      the settings can't be applied, the reason is provided in
+      message. */
+    bool apply_thread_settings(const thread_settings & settings,
+                               std::string & message);
+
+    /*! Actual policy, priority, nice value and CPU affinity of the
+      calling thread. */
+    std::string current_thread_settings(void);
+
+    /*! Lock all current and future pages of the process in memory
+      (mlockall) to avoid page faults in real-time threads.  Returns
+      false if the memory can't be locked, the reason is provided in
+      message. */
+    bool lock_memory(std::string & message);
+}
+
+#endif // _dvrk_thread_settings_h
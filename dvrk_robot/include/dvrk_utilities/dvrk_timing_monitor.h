@@ -0,0 +1,161 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-06-03
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_timing_monitor_h
+#define _dvrk_timing_monitor_h
+
+#include <atomic>
+#include <list>
+#include <vector>
+
+#include <cisstMultiTask/mtsComponent.h>
+
+#include <dvrk_utilities/dvrk_bridge.h>
+#include <dvrk_utilities/dvrk_latency_histogram.h>
+
+namespace dvrk {
+
+    /*! Component recording the time between runs of periodic tasks
+      (IO, arms, teleoperations, bridges...) in histograms so tail
+      latencies are visible, mtsIntervalStatistics only provides the
+      mean, standard deviation and extrema.  For each task added,
+      the required interface task_name + "-run" must be connected to
+      the task's "ExecOut" interface.  Intervals are recorded from a
+      non queued handler for the task's "RunEvent", i.e. in the
+      task's thread, without locks nor memory allocation.  A run is
+      counted as an overrun if the interval is greater than the
+      nominal period times the overrun ratio.
+
+      Statistics are collected by a single thread using Collect (see
+      dvrk::timing_statistics_publisher), each call returns the
+      statistics since the previous call as well as cumulative
+      counters since the component started.  A summary is also
+      logged every log period (see SetLogPeriod). */
+    class timing_monitor: public mtsComponent
+    {
+    public:
+        struct statistics {
+            std::string Name;
+            double NominalPeriod;
+            // since the last call to Collect, in seconds
+            size_t Count;
+            double P50;
+            double P99;
+            double P999;
+            double Max;
+            size_t Overruns;
+            // since the component started
+            uint64_t TotalCount;
+            uint64_t TotalOverruns;
+            double MaxEver;
+        };
+
+        timing_monitor(const std::string & component_name);
+
+        ~timing_monitor();
+
+        /*! Must be called before the component starts, returns false
+          if the task can't be added. */
+        bool AddTask(const std::string & task_name,
+                     const double & nominal_period_in_seconds);
+
+        /*! Ratio of the nominal period above which a run is counted as
+          an overrun, 1.2 by default. */
+        void SetOverrunRatio(const double & ratio);
+
+        /*! Period of the summary in the cisst log, 10 seconds by
+          default.  The summary is logged at the verbose level unless
+          a task overran.  Use 0 to turn off the summary. */
+        inline void SetLogPeriod(const double & period_in_seconds) {
+            mLogPeriod = period_in_seconds;
+        }
+
+        inline size_t NumberOfTasks(void) const {
+            return mTasks.size();
+        }
+
+        /*! Statistics for all tasks since the previous call.  This
+          must always be called from the same thread. */
+        void Collect(std::vector<statistics> & result);
+
+    protected:
+        void Log(void);
+
+        class task
+        {
+        public:
+            task(void);
+
+            /*! Non queued handler for the task's RunEvent, called from
+              the task's thread. */
+            void RunEventHandler(void);
+
+            /*! Swap the buffers and fill the statistics from the
+              buffer used since the last swap. */
+            void Collect(statistics & result);
+
+            std::string Name;
+            double NominalPeriod;
+            double OverrunThreshold;
+            double Last;
+            // double buffer, the task thread writes in the active one
+            latency_histogram Intervals[2];
+            size_t Overruns[2];
+            std::atomic<int> Active;
+            std::atomic<bool> Writing;
+            std::atomic<uint64_t> TotalCount;
+            std::atomic<uint64_t> TotalOverruns;
+            std::atomic<double> MaxEver;
+            // accumulated by Collect for the log summary
+            latency_histogram LogIntervals;
+            size_t LogOverruns;
+        };
+
+        typedef std::list<task *> TasksType;
+        TasksType mTasks;
+        double mOverrunRatio;
+        double mLogPeriod;
+        double mNextLog;
+    };
+
+    /*! Publish the statistics of a dvrk::timing_monitor on a
+      diagnostic_msgs/DiagnosticArray topic, one status per task
+      with level WARN if the task overran.  Times are in
+      milliseconds.  The monitor is collected every period even if
+      there is no subscriber so the log summary is still
+      produced. */
+    class timing_statistics_publisher: public publisher_base
+    {
+    public:
+        timing_statistics_publisher(timing_monitor * monitor,
+                                    const std::string & topic_name,
+                                    const double & period_in_seconds);
+
+        void Advertise(ros::NodeHandle & node_handle);
+
+        bool Execute(void);
+
+    protected:
+        timing_monitor * mMonitor;
+        double mPeriod;
+        double mNext;
+        std::vector<timing_monitor::statistics> mStatistics;
+    };
+}
+
+#endif // _dvrk_timing_monitor_h
@@ -0,0 +1,169 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-20
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _dvrk_topics_registry_h
+#define _dvrk_topics_registry_h
+
+#include <vector>
+
+#include <dvrk_utilities/dvrk_bridge.h>
+#include <dvrk_utilities/dvrk_topics_version.h>
+
+namespace dvrk {
+
+    /*! Number of values in dvrk_topics_version::version, must be
+      updated when a new version is added. */
+    const size_t number_of_topics_versions = dvrk_topics_version::compact_float32 + 1;
+
+    /*! List of topics versions to expose at once, e.g. v1_4_0 and
+      crtk_alpha during a migration.  Can be implicitly created from
+      a single version.  The compact versions only add joint state
+      topics (see dvrk_robot::CompactJointState) and are meant to be
+      used along another version. */
+    class topics_versions: public std::vector<dvrk_topics_version::version>
+    {
+    public:
+        topics_versions(void) {}
+
+        topics_versions(const dvrk_topics_version::version version) {
+            push_back(version);
+        }
+    };
+
+    /*! Function used to add a publisher or subscriber to a bridge.
+      The rate class is ignored by all functions but add_read. */
+    typedef bool (*add_topic_function)(dvrk::bridge & bridge,
+                                       const std::string & interface_required_name,
+                                       const std::string & command_name,
+                                       const std::string & topic_name,
+                                       const dvrk_topics_rate::rate rate);
+
+    /*! Publisher from a read command, see
+      bridge::AddPublisherFromCommandRead. */
+    template <typename _mtsType, typename _rosType>
+    bool add_read(dvrk::bridge & bridge,
+                  const std::string & interface_required_name,
+                  const std::string & command_name,
+                  const std::string & topic_name,
+                  const dvrk_topics_rate::rate rate)
+    {
+        return bridge.AddPublisherFromCommandRead<_mtsType, _rosType>
+            (interface_required_name, command_name, topic_name, rate);
+    }
+
+    /*! Publisher for a compact joint state (see
+      dvrk_robot::CompactJointState) from a read command returning a
+      prmStateJoint.  The joint names are published on the latched
+      topic topic_name + "/description" using the slow rate class. */
+    template <typename _rosType>
+    bool add_read_compact(dvrk::bridge & bridge,
+                          const std::string & interface_required_name,
+                          const std::string & command_name,
+                          const std::string & topic_name,
+                          const dvrk_topics_rate::rate rate)
+    {
+        return bridge.AddPublisherFromCommandRead<prmStateJoint, _rosType>
+            (interface_required_name, command_name, topic_name, rate)
+            && bridge.AddJointStateDescriptionPublisher
+            (interface_required_name, command_name, topic_name + "/description");
+    }
+
+    /*! Subscriber to a write command. */
+    template <typename _mtsType, typename _rosType>
+    bool add_write(dvrk::bridge & bridge,
+                   const std::string & interface_required_name,
+                   const std::string & command_name,
+                   const std::string & topic_name,
+                   const dvrk_topics_rate::rate CMN_UNUSED(rate))
+    {
+        return bridge.AddSubscriberToCommandWrite<_mtsType, _rosType>
+            (interface_required_name, command_name, topic_name);
+    }
+
+    /*! Subscriber to a write command only delivering the latest
+      message, see bridge::AddLatestSubscriberToCommandWrite. */
+    template <typename _mtsType, typename _rosType>
+    bool add_latest_write(dvrk::bridge & bridge,
+                          const std::string & interface_required_name,
+                          const std::string & command_name,
+                          const std::string & topic_name,
+                          const dvrk_topics_rate::rate CMN_UNUSED(rate))
+    {
+        return bridge.AddLatestSubscriberToCommandWrite<_mtsType, _rosType>
+            (interface_required_name, command_name, topic_name);
+    }
+
+    /*! Publisher from a write event. */
+    template <typename _mtsType, typename _rosType>
+    bool add_event_write(dvrk::bridge & bridge,
+                         const std::string & interface_required_name,
+                         const std::string & command_name,
+                         const std::string & topic_name,
+                         const dvrk_topics_rate::rate CMN_UNUSED(rate))
+    {
+        return bridge.AddPublisherFromEventWrite<_mtsType, _rosType>
+            (interface_required_name, command_name, topic_name);
+    }
+
+    /*! Topic name (relative to the ROS namespace) and function used
+      to add the topic for a given version.  Topic is 0 if the
+      command is not exposed in this version. */
+    struct topic_version {
+        const char * Topic;
+        add_topic_function Add;
+    };
+
+    /*! Entry of a topics table.  The required interface name is the
+      component name followed by Interface (e.g. "-servo").  Versions
+      is indexed by dvrk_topics_version::version. */
+    struct topic_entry {
+        const char * Interface;
+        const char * Command;
+        dvrk_topics_rate::rate Rate;
+        topic_version Versions[number_of_topics_versions];
+    };
+
+    /*! Add all the topics of a table for the given versions.  When
+      multiple versions are requested, commands are added once per
+      topic name, i.e. a topic shared by two versions is only added
+      once and the bridge reads each command once per cycle for all
+      the topics using it (see bridge::AddPublisherFromCommandRead).
+      Topics with the same name but a different message type in two
+      versions (e.g. v1_3_0 and v1_4_0) can't be served at once,
+      only the first version requested is used.  Returns false if
+      any of the topics couldn't be added. */
+    bool add_topics_from_table(dvrk::bridge & bridge,
+                               const std::string & ros_namespace,
+                               const std::string & component_name,
+                               const topics_versions & versions,
+                               const topic_entry * table,
+                               const size_t size);
+
+    template <size_t _size>
+    inline bool add_topics_from_table(dvrk::bridge & bridge,
+                                      const std::string & ros_namespace,
+                                      const std::string & component_name,
+                                      const topics_versions & versions,
+                                      const topic_entry (& table)[_size])
+    {
+        return add_topics_from_table(bridge, ros_namespace, component_name,
+                                     versions, table, _size);
+    }
+}
+
+#endif // _dvrk_topics_registry_h
@@ -17,11 +17,13 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <dvrk_utilities/dvrk_add_topics_functions.h>
+#include <dvrk_utilities/dvrk_topics_registry.h>
+#include <dvrk_utilities/dvrk_compact_joint_state.h>
 
 
-void dvrk::add_topics_console(mtsROSBridge & bridge,
+void dvrk::add_topics_console(dvrk::bridge & bridge,
                               const std::string & ros_namespace,
-                              const dvrk_topics_version::version CMN_UNUSED(version))
+                              const dvrk::topics_versions & CMN_UNUSED(versions))
 {
     bridge.AddSubscriberToCommandVoid
         ("Console", "PowerOff",
@@ -63,36 +65,37 @@ void dvrk::connect_bridge_console(const std::string & bridge_name,
                               console_component_name, "Main");
 }
 
-void dvrk::add_topics_footpedals(mtsROSBridge & bridge,
+// foot pedals, one interface per button
+static const dvrk::topic_entry footpedals_topics[] = {
+    {"Clutch", "Button", dvrk_topics_rate::fast,
+     {{"/clutch", &dvrk::add_event_write<prmEventButton, std_msgs::Bool>},
+      {"/clutch", &dvrk::add_event_write<prmEventButton, sensor_msgs::Joy>},
+      {"/clutch", &dvrk::add_event_write<prmEventButton, sensor_msgs::Joy>}}},
+    {"Coag", "Button", dvrk_topics_rate::fast,
+     {{"/coag", &dvrk::add_event_write<prmEventButton, std_msgs::Bool>},
+      {"/coag", &dvrk::add_event_write<prmEventButton, sensor_msgs::Joy>},
+      {"/coag", &dvrk::add_event_write<prmEventButton, sensor_msgs::Joy>}}},
+    {"Camera", "Button", dvrk_topics_rate::fast,
+     {{"/camera", &dvrk::add_event_write<prmEventButton, std_msgs::Bool>},
+      {"/camera", &dvrk::add_event_write<prmEventButton, sensor_msgs::Joy>},
+      {"/camera", &dvrk::add_event_write<prmEventButton, sensor_msgs::Joy>}}},
+    {"Cam+", "Button", dvrk_topics_rate::fast,
+     {{"/camera_plus", &dvrk::add_event_write<prmEventButton, std_msgs::Bool>},
+      {"/camera_plus", &dvrk::add_event_write<prmEventButton, sensor_msgs::Joy>},
+      {"/camera_plus", &dvrk::add_event_write<prmEventButton, sensor_msgs::Joy>}}},
+    {"Cam-", "Button", dvrk_topics_rate::fast,
+     {{"/camera_minus", &dvrk::add_event_write<prmEventButton, std_msgs::Bool>},
+      {"/camera_minus", &dvrk::add_event_write<prmEventButton, sensor_msgs::Joy>},
+      {"/camera_minus", &dvrk::add_event_write<prmEventButton, sensor_msgs::Joy>}}}
+};
+
+void dvrk::add_topics_footpedals(dvrk::bridge & bridge,
                                  const std::string & ros_namespace,
-                                 const dvrk_topics_version::version version)
-{
-    switch (version) {
-    case dvrk_topics_version::v1_3_0:
-        bridge.AddPublisherFromEventWrite<prmEventButton, std_msgs::Bool>
-            ("Clutch", "Button", ros_namespace + "/clutch");
-        bridge.AddPublisherFromEventWrite<prmEventButton, std_msgs::Bool>
-            ("Coag", "Button", ros_namespace + "/coag");
-        bridge.AddPublisherFromEventWrite<prmEventButton, std_msgs::Bool>
-            ("Camera", "Button", ros_namespace + "/camera");
-        bridge.AddPublisherFromEventWrite<prmEventButton, std_msgs::Bool>
-            ("Cam+", "Button", ros_namespace + "/camera_plus");
-        bridge.AddPublisherFromEventWrite<prmEventButton, std_msgs::Bool>
-            ("Cam-", "Button", ros_namespace + "/camera_minus");
-        break;
-    default:
-        bridge.AddPublisherFromEventWrite<prmEventButton, sensor_msgs::Joy>
-            ("Clutch", "Button", ros_namespace + "/clutch");
-        bridge.AddPublisherFromEventWrite<prmEventButton, sensor_msgs::Joy>
-            ("Coag", "Button", ros_namespace + "/coag");
-        bridge.AddPublisherFromEventWrite<prmEventButton, sensor_msgs::Joy>
-            ("Camera", "Button", ros_namespace + "/camera");
-        bridge.AddPublisherFromEventWrite<prmEventButton, sensor_msgs::Joy>
-            ("Cam+", "Button", ros_namespace + "/camera_plus");
-        bridge.AddPublisherFromEventWrite<prmEventButton, sensor_msgs::Joy>
-            ("Cam-", "Button", ros_namespace + "/camera_minus");
-        break;
-    }
+                                 const dvrk::topics_versions & versions)
+{
+    dvrk::add_topics_from_table(bridge, ros_namespace,
+                                "", versions,
+                                footpedals_topics);
 }
 
 void dvrk::connect_bridge_footpedals(const std::string & bridge_name,
@@ -111,104 +114,104 @@ void dvrk::connect_bridge_footpedals(const std::string & bridge_name,
                               io_component_name, "CAM-");
 }
 
-void dvrk::add_topics_arm(mtsROSBridge & bridge,
+// read commands common to all arms
+static const dvrk::topic_entry arm_read_topics[] = {
+    {"", "GetPositionJoint", dvrk_topics_rate::fast,
+     {{"/position_joint_current", &dvrk::add_read<prmPositionJointGet, sensor_msgs::JointState>},
+      {0, 0},
+      {0, 0}}},
+    {"", "GetPositionJointDesired", dvrk_topics_rate::fast,
+     {{"/position_joint_desired", &dvrk::add_read<vctDoubleVec, sensor_msgs::JointState>},
+      {0, 0},
+      {0, 0}}},
+    {"", "GetStateJoint", dvrk_topics_rate::fast,
+     {{"/state_joint_current", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/state_joint_current", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/measured_js", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/compact/measured_js", &dvrk::add_read_compact<dvrk_robot::CompactJointState>},
+      {"/compact32/measured_js", &dvrk::add_read_compact<dvrk_robot::CompactJointState32>}}},
+    {"", "GetStateJointDesired", dvrk_topics_rate::fast,
+     {{"/state_joint_desired", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/state_joint_desired", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/setpoint_js", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/compact/setpoint_js", &dvrk::add_read_compact<dvrk_robot::CompactJointState>},
+      {"/compact32/setpoint_js", &dvrk::add_read_compact<dvrk_robot::CompactJointState32>}}},
+    {"", "GetPositionCartesianLocal", dvrk_topics_rate::medium,
+     {{"/position_cartesian_local_current", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::Pose>},
+      {"/position_cartesian_local_current", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::PoseStamped>},
+      {"/local/measured_cp", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::TransformStamped>}}},
+    {"", "GetPositionCartesianLocalDesired", dvrk_topics_rate::medium,
+     {{"/position_cartesian_local_desired", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::Pose>},
+      {"/position_cartesian_local_desired", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::PoseStamped>},
+      {"/local/setpoint_cp", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::TransformStamped>}}},
+    {"", "GetPositionCartesian", dvrk_topics_rate::fast,
+     {{"/position_cartesian_current", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::Pose>},
+      {"/position_cartesian_current", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::PoseStamped>},
+      {"/measured_cp", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::TransformStamped>}}},
+    {"", "GetPositionCartesianDesired", dvrk_topics_rate::fast,
+     {{"/position_cartesian_desired", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::Pose>},
+      {"/position_cartesian_desired", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::PoseStamped>},
+      {"/setpoint_cp", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::TransformStamped>}}},
+    {"", "GetVelocityCartesian", dvrk_topics_rate::medium,
+     {{0, 0},
+      {"/twist_body_current", &dvrk::add_read<prmVelocityCartesianGet, geometry_msgs::TwistStamped>},
+      {"/measured_cv", &dvrk::add_read<prmVelocityCartesianGet, geometry_msgs::TwistStamped>}}},
+    {"", "GetWrenchBody", dvrk_topics_rate::medium,
+     {{0, 0},
+      {"/wrench_body_current", &dvrk::add_read<prmForceCartesianGet, geometry_msgs::WrenchStamped>},
+      {"/body/measured_cf", &dvrk::add_read<prmForceCartesianGet, geometry_msgs::WrenchStamped>}}},
+    {"", "GetJacobianBody", dvrk_topics_rate::slow,
+     {{0, 0},
+      {"/jacobian_body", &dvrk::add_read<vctDoubleMat, std_msgs::Float64MultiArray>},
+      {"/body/jacobian", &dvrk::add_read<vctDoubleMat, std_msgs::Float64MultiArray>}}},
+    {"", "GetJacobianSpatial", dvrk_topics_rate::slow,
+     {{0, 0},
+      {"/jacobian_spatial", &dvrk::add_read<vctDoubleMat, std_msgs::Float64MultiArray>},
+      {"/spatial/jacobian", &dvrk::add_read<vctDoubleMat, std_msgs::Float64MultiArray>}}}
+};
+
+// motion commands common to all arms, servo commands only deliver
+// the latest setpoint received (see connect_bridge_arm_servo)
+static const dvrk::topic_entry arm_motion_topics[] = {
+    {"-servo", "SetPositionJoint", dvrk_topics_rate::fast,
+     {{"/set_position_joint", &dvrk::add_latest_write<prmPositionJointSet, sensor_msgs::JointState>},
+      {"/set_position_joint", &dvrk::add_latest_write<prmPositionJointSet, sensor_msgs::JointState>},
+      {"/servo_jp", &dvrk::add_latest_write<prmPositionJointSet, sensor_msgs::JointState>}}},
+    {"", "SetPositionGoalJoint", dvrk_topics_rate::fast,
+     {{"/set_position_goal_joint", &dvrk::add_write<prmPositionJointSet, sensor_msgs::JointState>},
+      {"/set_position_goal_joint", &dvrk::add_write<prmPositionJointSet, sensor_msgs::JointState>},
+      {"/move_jp", &dvrk::add_write<prmPositionJointSet, sensor_msgs::JointState>}}},
+    {"-servo", "SetPositionCartesian", dvrk_topics_rate::fast,
+     {{"/set_position_cartesian", &dvrk::add_latest_write<prmPositionCartesianSet, geometry_msgs::Pose>},
+      {"/set_position_cartesian", &dvrk::add_latest_write<prmPositionCartesianSet, geometry_msgs::Pose>},
+      {"/servo_cp", &dvrk::add_latest_write<prmPositionCartesianSet, geometry_msgs::TransformStamped>}}},
+    {"", "SetPositionGoalCartesian", dvrk_topics_rate::fast,
+     {{"/set_position_goal_cartesian", &dvrk::add_write<prmPositionCartesianSet, geometry_msgs::Pose>},
+      {"/set_position_goal_cartesian", &dvrk::add_write<prmPositionCartesianSet, geometry_msgs::Pose>},
+      {"/move_cp", &dvrk::add_write<prmPositionCartesianSet, geometry_msgs::TransformStamped>}}},
+    {"-servo", "SetEffortJoint", dvrk_topics_rate::fast,
+     {{"/set_effort_joint", &dvrk::add_latest_write<prmForceTorqueJointSet, sensor_msgs::JointState>},
+      {"/set_effort_joint", &dvrk::add_latest_write<prmForceTorqueJointSet, sensor_msgs::JointState>},
+      {"/servo_jf", &dvrk::add_latest_write<prmForceTorqueJointSet, sensor_msgs::JointState>}}},
+    {"-servo", "SetWrenchBody", dvrk_topics_rate::fast,
+     {{"/set_wrench_body", &dvrk::add_latest_write<prmForceCartesianSet, geometry_msgs::Wrench>},
+      {"/set_wrench_body", &dvrk::add_latest_write<prmForceCartesianSet, geometry_msgs::Wrench>},
+      {"/body/servo_cf", &dvrk::add_latest_write<prmForceCartesianSet, geometry_msgs::WrenchStamped>}}},
+    {"-servo", "SetWrenchSpatial", dvrk_topics_rate::fast,
+     {{"/set_wrench_spatial", &dvrk::add_latest_write<prmForceCartesianSet, geometry_msgs::Wrench>},
+      {"/set_wrench_spatial", &dvrk::add_latest_write<prmForceCartesianSet, geometry_msgs::Wrench>},
+      {"/spatial/servo_cf", &dvrk::add_latest_write<prmForceCartesianSet, geometry_msgs::WrenchStamped>}}}
+};
+
+void dvrk::add_topics_arm(dvrk::bridge & bridge,
                           const std::string & ros_namespace,
                           const std::string & arm_component_name,
-                          const dvrk_topics_version::version version)
+                          const dvrk::topics_versions & versions)
 {
     // read
-    switch (version) {
-    case dvrk_topics_version::v1_3_0:
-        bridge.AddPublisherFromCommandRead<prmPositionJointGet, sensor_msgs::JointState>
-            (arm_component_name, "GetPositionJoint",
-             ros_namespace + "/position_joint_current");
-        bridge.AddPublisherFromCommandRead<vctDoubleVec, sensor_msgs::JointState>
-            (arm_component_name, "GetPositionJointDesired",
-             ros_namespace + "/position_joint_desired");
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (arm_component_name, "GetStateJoint",
-             ros_namespace + "/state_joint_current");
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (arm_component_name, "GetStateJointDesired",
-             ros_namespace + "/state_joint_desired");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::Pose>
-            (arm_component_name, "GetPositionCartesianLocal",
-             ros_namespace + "/position_cartesian_local_current");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::Pose>
-            (arm_component_name, "GetPositionCartesianLocalDesired",
-             ros_namespace + "/position_cartesian_local_desired");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::Pose>
-            (arm_component_name, "GetPositionCartesian",
-             ros_namespace + "/position_cartesian_current");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::Pose>
-            (arm_component_name, "GetPositionCartesianDesired",
-             ros_namespace + "/position_cartesian_desired");
-        break;
-    case dvrk_topics_version::crtk_alpha:
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (arm_component_name, "GetStateJoint",
-             ros_namespace + "/measured_js");
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (arm_component_name, "GetStateJointDesired",
-             ros_namespace + "/setpoint_js");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::TransformStamped>
-            (arm_component_name, "GetPositionCartesianLocal",
-             ros_namespace + "/local/measured_cp");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::TransformStamped>
-            (arm_component_name, "GetPositionCartesianLocalDesired",
-             ros_namespace + "/local/setpoint_cp");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::TransformStamped>
-            (arm_component_name, "GetPositionCartesian",
-             ros_namespace + "/measured_cp");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::TransformStamped>
-            (arm_component_name, "GetPositionCartesianDesired",
-             ros_namespace + "/setpoint_cp");
-        bridge.AddPublisherFromCommandRead<prmVelocityCartesianGet, geometry_msgs::TwistStamped>
-            (arm_component_name, "GetVelocityCartesian",
-             ros_namespace + "/measured_cv");
-        bridge.AddPublisherFromCommandRead<prmForceCartesianGet, geometry_msgs::WrenchStamped>
-            (arm_component_name, "GetWrenchBody",
-             ros_namespace + "/body/measured_cf");
-        bridge.AddPublisherFromCommandRead<vctDoubleMat, std_msgs::Float64MultiArray>
-            (arm_component_name, "GetJacobianBody",
-             ros_namespace + "/body/jacobian");
-        bridge.AddPublisherFromCommandRead<vctDoubleMat, std_msgs::Float64MultiArray>
-            (arm_component_name, "GetJacobianSpatial",
-             ros_namespace + "/spatial/jacobian");
-        break;
-    default:
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (arm_component_name, "GetStateJoint",
-             ros_namespace + "/state_joint_current");
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (arm_component_name, "GetStateJointDesired",
-             ros_namespace + "/state_joint_desired");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::PoseStamped>
-            (arm_component_name, "GetPositionCartesianLocal",
-             ros_namespace + "/position_cartesian_local_current");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::PoseStamped>
-            (arm_component_name, "GetPositionCartesianLocalDesired",
-             ros_namespace + "/position_cartesian_local_desired");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::PoseStamped>
-            (arm_component_name, "GetPositionCartesian",
-             ros_namespace + "/position_cartesian_current");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::PoseStamped>
-            (arm_component_name, "GetPositionCartesianDesired",
-             ros_namespace + "/position_cartesian_desired");
-        bridge.AddPublisherFromCommandRead<prmVelocityCartesianGet, geometry_msgs::TwistStamped>
-            (arm_component_name, "GetVelocityCartesian",
-             ros_namespace + "/twist_body_current");
-        bridge.AddPublisherFromCommandRead<prmForceCartesianGet, geometry_msgs::WrenchStamped>
-            (arm_component_name, "GetWrenchBody",
-             ros_namespace + "/wrench_body_current");
-        bridge.AddPublisherFromCommandRead<vctDoubleMat, std_msgs::Float64MultiArray>
-            (arm_component_name, "GetJacobianBody",
-             ros_namespace + "/jacobian_body");
-        bridge.AddPublisherFromCommandRead<vctDoubleMat, std_msgs::Float64MultiArray>
-            (arm_component_name, "GetJacobianSpatial",
-             ros_namespace + "/jacobian_spatial");
-        break;
-    }
+    dvrk::add_topics_from_table(bridge, ros_namespace,
+                                arm_component_name, versions,
+                                arm_read_topics);
 
     // write
     bridge.AddSubscriberToCommandWrite<prmPositionCartesianSet, geometry_msgs::Pose>
@@ -224,54 +227,13 @@ void dvrk::add_topics_arm(mtsROSBridge & bridge,
         (arm_component_name, "SetJointAccelerationRatio",
          ros_namespace + "/set_joint_acceleration_ratio");
 
-    switch (version) {
-    case dvrk_topics_version::crtk_alpha:
-        bridge.AddSubscriberToCommandWrite<prmPositionJointSet, sensor_msgs::JointState>
-            (arm_component_name, "SetPositionJoint",
-             ros_namespace + "/servo_jp");
-        bridge.AddSubscriberToCommandWrite<prmPositionJointSet, sensor_msgs::JointState>
-            (arm_component_name, "SetPositionGoalJoint",
-             ros_namespace + "/move_jp");
-        bridge.AddSubscriberToCommandWrite<prmPositionCartesianSet, geometry_msgs::TransformStamped>
-            (arm_component_name, "SetPositionCartesian",
-             ros_namespace + "/servo_cp");
-        bridge.AddSubscriberToCommandWrite<prmPositionCartesianSet, geometry_msgs::TransformStamped>
-            (arm_component_name, "SetPositionGoalCartesian",
-             ros_namespace + "/move_cp");
-        bridge.AddSubscriberToCommandWrite<prmForceTorqueJointSet, sensor_msgs::JointState>
-            (arm_component_name, "SetEffortJoint",
-             ros_namespace + "/servo_jf");
-        bridge.AddSubscriberToCommandWrite<prmForceCartesianSet, geometry_msgs::WrenchStamped>
-            (arm_component_name, "SetWrenchBody",
-             ros_namespace + "/body/servo_cf");
-        bridge.AddSubscriberToCommandWrite<prmForceCartesianSet, geometry_msgs::WrenchStamped>
-            (arm_component_name, "SetWrenchSpatial",
-             ros_namespace + "/spatial/servo_cf");
-        break;
-    default:
-        bridge.AddSubscriberToCommandWrite<prmPositionJointSet, sensor_msgs::JointState>
-            (arm_component_name, "SetPositionJoint",
-             ros_namespace + "/set_position_joint");
-        bridge.AddSubscriberToCommandWrite<prmPositionJointSet, sensor_msgs::JointState>
-            (arm_component_name, "SetPositionGoalJoint",
-             ros_namespace + "/set_position_goal_joint");
-        bridge.AddSubscriberToCommandWrite<prmPositionCartesianSet, geometry_msgs::Pose>
-            (arm_component_name, "SetPositionCartesian",
-             ros_namespace + "/set_position_cartesian");
-        bridge.AddSubscriberToCommandWrite<prmPositionCartesianSet, geometry_msgs::Pose>
-            (arm_component_name, "SetPositionGoalCartesian",
-             ros_namespace + "/set_position_goal_cartesian");
-        bridge.AddSubscriberToCommandWrite<prmForceTorqueJointSet, sensor_msgs::JointState>
-            (arm_component_name, "SetEffortJoint",
-             ros_namespace + "/set_effort_joint");
-        bridge.AddSubscriberToCommandWrite<prmForceCartesianSet, geometry_msgs::Wrench>
-            (arm_component_name, "SetWrenchBody",
-             ros_namespace + "/set_wrench_body");
-        bridge.AddSubscriberToCommandWrite<prmForceCartesianSet, geometry_msgs::Wrench>
-            (arm_component_name, "SetWrenchSpatial",
-             ros_namespace + "/set_wrench_spatial");
-        break;
-    }
+    dvrk::add_topics_from_table(bridge, ros_namespace,
+                                arm_component_name, versions,
+                                arm_motion_topics);
+
+    // Jacobians on demand
+    bridge.AddJacobianService(arm_component_name + "-jacobian",
+                              ros_namespace + "/query_jacobian");
 
     bridge.AddSubscriberToCommandWrite<bool, std_msgs::Bool>
         (arm_component_name, "SetWrenchBodyOrientationAbsolute",
@@ -320,14 +282,66 @@ void dvrk::add_topics_arm(mtsROSBridge & bridge,
                                 mtsROSEventWriteLog::ROS_LOG_INFO);
 }
 
-void dvrk::add_topics_mtm(mtsROSBridge & bridge,
+void dvrk::add_topics_arm_state(dvrk::bridge & bridge,
+                                const std::string & ros_namespace,
+                                const std::string & arm_component_name)
+{
+    bridge.AddArmStatePublisher(arm_component_name + "-state",
+                                ros_namespace + "/state");
+}
+
+void dvrk::connect_bridge_arm_state(const std::string & bridge_name,
+                                    const std::string & arm_name,
+                                    const std::string & arm_component_name,
+                                    const std::string & arm_interface_name)
+{
+    mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+    componentManager->Connect(bridge_name, arm_name + "-state",
+                              arm_component_name, arm_interface_name);
+}
+
+void dvrk::connect_bridge_arm_jacobian(const std::string & bridge_name,
+                                       const std::string & arm_name,
+                                       const std::string & arm_component_name,
+                                       const std::string & arm_interface_name)
+{
+    mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+    componentManager->Connect(bridge_name, arm_name + "-jacobian",
+                              arm_component_name, arm_interface_name);
+}
+
+void dvrk::connect_bridge_arm_servo(const std::string & bridge_name,
+                                    const std::string & arm_name,
+                                    const std::string & arm_component_name,
+                                    const std::string & arm_interface_name)
+{
+    mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+    componentManager->Connect(bridge_name, arm_name + "-servo",
+                              arm_component_name, arm_interface_name);
+    componentManager->Connect(bridge_name, arm_name + "-servo-run",
+                              arm_component_name, "ExecOut");
+}
+
+// mtm specific
+static const dvrk::topic_entry mtm_topics[] = {
+    {"", "GetStateGripper", dvrk_topics_rate::fast,
+     {{"/state_gripper_current", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/state_gripper_current", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/gripper/measured_js", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/compact/gripper/measured_js", &dvrk::add_read_compact<dvrk_robot::CompactJointState>},
+      {"/compact32/gripper/measured_js", &dvrk::add_read_compact<dvrk_robot::CompactJointState32>}}}
+};
+
+void dvrk::add_topics_mtm(dvrk::bridge & bridge,
                           const std::string & ros_namespace,
                           const std::string & mtm_component_name,
-                          const dvrk_topics_version::version version)
+                          const dvrk::topics_versions & versions)
 {
     // arm API
     dvrk::add_topics_arm(bridge, ros_namespace,
-                         mtm_component_name, version);
+                         mtm_component_name, versions);
+    dvrk::add_topics_arm_state(bridge, ros_namespace,
+                               mtm_component_name);
 
     // mtm specific API
     bridge.AddSubscriberToCommandWrite<vctMatRot3, geometry_msgs::Quaternion>
@@ -343,24 +357,15 @@ void dvrk::add_topics_mtm(mtsROSBridge & bridge,
         (mtm_component_name, "GripperClosedEvent",
          ros_namespace + "/gripper_closed_event");
 
-    switch (version) {
-    case dvrk_topics_version::crtk_alpha:
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (mtm_component_name, "GetStateGripper",
-             ros_namespace + "/gripper/measured_js");
-        break;
-    default:
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (mtm_component_name, "GetStateGripper",
-             ros_namespace + "/state_gripper_current");
-        break;
-    }
-}
-
-void dvrk::add_topics_mtm_generic(mtsROSBridge & bridge,
+    dvrk::add_topics_from_table(bridge, ros_namespace,
+                                mtm_component_name, versions,
+                                mtm_topics);
+}
+
+void dvrk::add_topics_mtm_generic(dvrk::bridge & bridge,
                                   const std::string & ros_namespace,
                                   const std::string & arm_component_name,
-                                  const dvrk_topics_version::version CMN_UNUSED(version))
+                                  const dvrk::topics_versions & CMN_UNUSED(versions))
 {
     // read
     bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::PoseStamped>
@@ -368,10 +373,12 @@ void dvrk::add_topics_mtm_generic(mtsROSBridge & bridge,
          ros_namespace + "/position_cartesian_current");
     bridge.AddPublisherFromCommandRead<prmVelocityCartesianGet, geometry_msgs::TwistStamped>
         (arm_component_name, "GetVelocityCartesian",
-         ros_namespace + "/twist_body_current");
+         ros_namespace + "/twist_body_current",
+         dvrk_topics_rate::medium);
     bridge.AddPublisherFromCommandRead<prmForceCartesianGet, geometry_msgs::WrenchStamped>
         (arm_component_name, "GetWrenchBody",
-         ros_namespace + "/wrench_body_current");
+         ros_namespace + "/wrench_body_current",
+         dvrk_topics_rate::medium);
     bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
         (arm_component_name, "GetStateGripper",
          ros_namespace + "/state_gripper_current");
@@ -422,54 +429,71 @@ void dvrk::connect_bridge_mtm(const std::string & bridge_name,
                               mtm_component_name, mtm_interface_name);
     componentManager->Connect(bridge_name, arm_name + "-log",
                               mtm_component_name, mtm_interface_name);
+    dvrk::connect_bridge_arm_state(bridge_name, arm_name,
+                                   mtm_component_name, mtm_interface_name);
+    dvrk::connect_bridge_arm_servo(bridge_name, arm_name,
+                                   mtm_component_name, mtm_interface_name);
+    dvrk::connect_bridge_arm_jacobian(bridge_name, arm_name,
+                                      mtm_component_name, mtm_interface_name);
 }
 
-void dvrk::add_topics_psm(mtsROSBridge & bridge,
+void dvrk::connect_bridge_mtm_generic(const std::string & bridge_name,
+                                      const std::string & arm_name,
+                                      const std::string & mtm_component_name,
+                                      const std::string & mtm_interface_name)
+{
+    // add_topics_mtm_generic doesn't add state, servo nor jacobian
+    // interfaces
+    mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+    componentManager->Connect(bridge_name, arm_name,
+                              mtm_component_name, mtm_interface_name);
+    componentManager->Connect(bridge_name, arm_name + "-log",
+                              mtm_component_name, mtm_interface_name);
+}
+
+// psm specific
+static const dvrk::topic_entry psm_topics[] = {
+    {"", "SetPositionJaw", dvrk_topics_rate::fast,
+     {{"/set_position_jaw", &dvrk::add_write<prmPositionJointSet, sensor_msgs::JointState>},
+      {"/set_position_jaw", &dvrk::add_write<prmPositionJointSet, sensor_msgs::JointState>},
+      {"/jaw/servo_jp", &dvrk::add_write<prmPositionJointSet, sensor_msgs::JointState>}}},
+    {"", "SetPositionGoalJaw", dvrk_topics_rate::fast,
+     {{"/set_position_goal_jaw", &dvrk::add_write<prmPositionJointSet, sensor_msgs::JointState>},
+      {"/set_position_goal_jaw", &dvrk::add_write<prmPositionJointSet, sensor_msgs::JointState>},
+      {"/jaw/move_jp", &dvrk::add_write<prmPositionJointSet, sensor_msgs::JointState>}}},
+    {"", "SetEffortJaw", dvrk_topics_rate::fast,
+     {{"/set_effort_jaw", &dvrk::add_write<prmForceTorqueJointSet, sensor_msgs::JointState>},
+      {"/set_effort_jaw", &dvrk::add_write<prmForceTorqueJointSet, sensor_msgs::JointState>},
+      {"/jaw/servo_jf", &dvrk::add_write<prmForceTorqueJointSet, sensor_msgs::JointState>}}},
+    {"", "GetStateJawDesired", dvrk_topics_rate::fast,
+     {{"/state_jaw_desired", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/state_jaw_desired", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/jaw/setpoint_js", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/compact/jaw/setpoint_js", &dvrk::add_read_compact<dvrk_robot::CompactJointState>},
+      {"/compact32/jaw/setpoint_js", &dvrk::add_read_compact<dvrk_robot::CompactJointState32>}}},
+    {"", "GetStateJaw", dvrk_topics_rate::fast,
+     {{"/state_jaw_current", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/state_jaw_current", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/jaw/measured_js", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/compact/jaw/measured_js", &dvrk::add_read_compact<dvrk_robot::CompactJointState>},
+      {"/compact32/jaw/measured_js", &dvrk::add_read_compact<dvrk_robot::CompactJointState32>}}}
+};
+
+void dvrk::add_topics_psm(dvrk::bridge & bridge,
                           const std::string & ros_namespace,
                           const std::string & psm_component_name,
-                          const dvrk_topics_version::version version)
+                          const dvrk::topics_versions & versions)
 {
     // arm API
     dvrk::add_topics_arm(bridge, ros_namespace,
-                         psm_component_name, version);
+                         psm_component_name, versions);
+    dvrk::add_topics_arm_state(bridge, ros_namespace,
+                               psm_component_name);
 
     // psm specific API
-    switch (version) {
-    case dvrk_topics_version::crtk_alpha:
-        bridge.AddSubscriberToCommandWrite<prmPositionJointSet, sensor_msgs::JointState>
-            (psm_component_name, "SetPositionJaw",
-             ros_namespace + "/jaw/servo_jp");
-        bridge.AddSubscriberToCommandWrite<prmPositionJointSet, sensor_msgs::JointState>
-            (psm_component_name, "SetPositionGoalJaw",
-             ros_namespace + "/jaw/move_jp");
-        bridge.AddSubscriberToCommandWrite<prmForceTorqueJointSet, sensor_msgs::JointState>
-            (psm_component_name, "SetEffortJaw",
-             ros_namespace + "/jaw/servo_jf");
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (psm_component_name, "GetStateJawDesired",
-             ros_namespace + "/jaw/setpoint_js");
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (psm_component_name, "GetStateJaw",
-             ros_namespace + "/jaw/measured_js");
-        break;
-    default:
-        bridge.AddSubscriberToCommandWrite<prmPositionJointSet, sensor_msgs::JointState>
-            (psm_component_name, "SetPositionJaw",
-             ros_namespace + "/set_position_jaw");
-        bridge.AddSubscriberToCommandWrite<prmPositionJointSet, sensor_msgs::JointState>
-            (psm_component_name, "SetPositionGoalJaw",
-             ros_namespace + "/set_position_goal_jaw");
-        bridge.AddSubscriberToCommandWrite<prmForceTorqueJointSet, sensor_msgs::JointState>
-            (psm_component_name, "SetEffortJaw",
-             ros_namespace + "/set_effort_jaw");
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (psm_component_name, "GetStateJawDesired",
-             ros_namespace + "/state_jaw_desired");
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (psm_component_name, "GetStateJaw",
-             ros_namespace + "/state_jaw_current");
-        break;
-    }
+    dvrk::add_topics_from_table(bridge, ros_namespace,
+                                psm_component_name, versions,
+                                psm_topics);
 
     bridge.AddSubscriberToCommandWrite<bool, std_msgs::Bool>
         (psm_component_name, "SetAdapterPresent",
@@ -495,12 +519,18 @@ void dvrk::connect_bridge_psm(const std::string & bridge_name,
                               psm_component_name, psm_interface_name);
     componentManager->Connect(bridge_name, arm_name + "-log",
                               psm_component_name, psm_interface_name);
+    dvrk::connect_bridge_arm_state(bridge_name, arm_name,
+                                   psm_component_name, psm_interface_name);
+    dvrk::connect_bridge_arm_servo(bridge_name, arm_name,
+                                   psm_component_name, psm_interface_name);
+    dvrk::connect_bridge_arm_jacobian(bridge_name, arm_name,
+                                      psm_component_name, psm_interface_name);
 }
 
-void dvrk::add_topics_psm_io(mtsROSBridge & bridge,
+void dvrk::add_topics_psm_io(dvrk::bridge & bridge,
                              const std::string & ros_namespace,
                              const std::string & arm_name,
-                             const dvrk_topics_version::version CMN_UNUSED(version))
+                             const dvrk::topics_versions & CMN_UNUSED(versions))
 {
     bridge.AddPublisherFromEventWrite<prmEventButton, sensor_msgs::Joy>
         (arm_name + "-ManipClutch", "Button", ros_namespace + "/io/manip_clutch");
@@ -532,28 +562,31 @@ void dvrk::connect_bridge_psm_io(const std::string & bridge_name,
                               io_component_name, interfaceName);
 }
 
-void dvrk::add_topics_ecm(mtsROSBridge & bridge,
+// ecm specific
+static const dvrk::topic_entry ecm_topics[] = {
+    {"", "ManipClutch", dvrk_topics_rate::fast,
+     {{"/manip_clutch", &dvrk::add_event_write<prmEventButton, std_msgs::Bool>},
+      {"/manip_clutch", &dvrk::add_event_write<prmEventButton, sensor_msgs::Joy>},
+      {"/manip_clutch", &dvrk::add_event_write<prmEventButton, sensor_msgs::Joy>}}}
+};
+
+void dvrk::add_topics_ecm(dvrk::bridge & bridge,
                           const std::string & ros_namespace,
                           const std::string & ecm_component_name,
-                          const dvrk_topics_version::version version)
+                          const dvrk::topics_versions & versions)
 {
     // arm API
     dvrk::add_topics_arm(bridge, ros_namespace,
-                         ecm_component_name, version);
+                         ecm_component_name, versions);
+    dvrk::add_topics_arm_state(bridge, ros_namespace,
+                               ecm_component_name);
 
     // ecm specific API
 
     // events
-    switch (version) {
-    case dvrk_topics_version::v1_3_0:
-        bridge.AddPublisherFromEventWrite<prmEventButton, std_msgs::Bool>
-            (ecm_component_name, "ManipClutch", ros_namespace + "/manip_clutch");
-        break;
-    default:
-        bridge.AddPublisherFromEventWrite<prmEventButton, sensor_msgs::Joy>
-            (ecm_component_name, "ManipClutch", ros_namespace + "/manip_clutch");
-        break;
-    }
+    dvrk::add_topics_from_table(bridge, ros_namespace,
+                                ecm_component_name, versions,
+                                ecm_topics);
 }
 
 void dvrk::connect_bridge_ecm(const std::string & bridge_name,
@@ -566,12 +599,18 @@ void dvrk::connect_bridge_ecm(const std::string & bridge_name,
                               ecm_component_name, ecm_interface_name);
     componentManager->Connect(bridge_name, arm_name + "-log",
                               ecm_component_name, ecm_interface_name);
+    dvrk::connect_bridge_arm_state(bridge_name, arm_name,
+                                   ecm_component_name, ecm_interface_name);
+    dvrk::connect_bridge_arm_servo(bridge_name, arm_name,
+                                   ecm_component_name, ecm_interface_name);
+    dvrk::connect_bridge_arm_jacobian(bridge_name, arm_name,
+                                      ecm_component_name, ecm_interface_name);
 }
 
-void dvrk::add_topics_ecm_io(mtsROSBridge & bridge,
+void dvrk::add_topics_ecm_io(dvrk::bridge & bridge,
                              const std::string & ros_namespace,
                              const std::string & arm_name,
-                             const dvrk_topics_version::version CMN_UNUSED(version))
+                             const dvrk::topics_versions & CMN_UNUSED(versions))
 {
     bridge.AddPublisherFromEventWrite<prmEventButton, sensor_msgs::Joy>
         (arm_name + "-ManipClutch", "Button", ros_namespace + "/io/manip_clutch");
@@ -593,10 +632,22 @@ void dvrk::connect_bridge_ecm_io(const std::string & bridge_name,
                               io_component_name, interfaceName);
 }
 
-void dvrk::add_topics_teleop(mtsROSBridge & bridge,
+// teleop events depending on version
+static const dvrk::topic_entry teleop_topics[] = {
+    {"", "RotationLocked", dvrk_topics_rate::fast,
+     {{"/rotation_locked", &dvrk::add_event_write<bool, std_msgs::Bool>},
+      {"/rotation_locked", &dvrk::add_event_write<bool, sensor_msgs::Joy>},
+      {"/rotation_locked", &dvrk::add_event_write<bool, sensor_msgs::Joy>}}},
+    {"", "TranslationLocked", dvrk_topics_rate::fast,
+     {{"/translation_locked", &dvrk::add_event_write<bool, std_msgs::Bool>},
+      {"/translation_locked", &dvrk::add_event_write<bool, sensor_msgs::Joy>},
+      {"/translation_locked", &dvrk::add_event_write<bool, sensor_msgs::Joy>}}}
+};
+
+void dvrk::add_topics_teleop(dvrk::bridge & bridge,
                              const std::string & ros_namespace,
                              const std::string & teleop_component_name,
-                             const dvrk_topics_version::version version)
+                             const dvrk::topics_versions & versions)
 {
     // messages
     bridge.AddLogFromEventWrite(teleop_component_name + "-log", "Error",
@@ -611,22 +662,9 @@ void dvrk::add_topics_teleop(mtsROSBridge & bridge,
         (teleop_component_name, "DesiredState", ros_namespace + "/desired_state");
     bridge.AddPublisherFromEventWrite<std::string, std_msgs::String>
         (teleop_component_name, "CurrentState", ros_namespace + "/current_state");
-    switch (version) {
-    case dvrk_topics_version::v1_3_0:
-        bridge.AddPublisherFromEventWrite<bool, std_msgs::Bool>
-            (teleop_component_name, "RotationLocked", ros_namespace + "/rotation_locked");
-        bridge.AddPublisherFromEventWrite<bool, std_msgs::Bool>
-            (teleop_component_name, "TranslationLocked", ros_namespace + "/translation_locked");
-        break;
-    default:
-        bridge.AddPublisherFromEventWrite<bool, sensor_msgs::Joy>
-            (teleop_component_name, "RotationLocked",
-             ros_namespace + "/rotation_locked");
-        bridge.AddPublisherFromEventWrite<bool, sensor_msgs::Joy>
-            (teleop_component_name, "TranslationLocked",
-             ros_namespace + "/translation_locked");
-        break;
-    }
+    dvrk::add_topics_from_table(bridge, ros_namespace,
+                                teleop_component_name, versions,
+                                teleop_topics);
     bridge.AddPublisherFromEventWrite<double, std_msgs::Float32>
         (teleop_component_name, "Scale", ros_namespace + "/scale");
     bridge.AddPublisherFromEventWrite<bool, std_msgs::Bool>
@@ -660,50 +698,35 @@ void dvrk::connect_bridge_teleop(const std::string & bridge_name,
                               teleop_component_name, "Setting");
 }
 
-void dvrk::add_topics_suj(mtsROSBridge & bridge,
+// suj, events up to 1.4, read commands for crtk
+static const dvrk::topic_entry suj_topics[] = {
+    {"-suj", "GetStateJoint", dvrk_topics_rate::fast,
+     {{0, 0},
+      {"/state_joint_current", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>},
+      {"/measured_js", &dvrk::add_read<prmStateJoint, sensor_msgs::JointState>}}},
+    {"-suj", "SetPositionJoint", dvrk_topics_rate::fast,
+     {{0, 0},
+      {"/set_position_joint", &dvrk::add_write<prmPositionJointSet, sensor_msgs::JointState>},
+      {"/servo_jp", &dvrk::add_write<prmPositionJointSet, sensor_msgs::JointState>}}},
+    {"-suj", "PositionCartesian", dvrk_topics_rate::fast,
+     {{"/position_cartesian_current", &dvrk::add_event_write<prmPositionCartesianGet, geometry_msgs::Pose>},
+      {"/position_cartesian_current", &dvrk::add_event_write<prmPositionCartesianGet, geometry_msgs::PoseStamped>},
+      {"/measured_cp", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::TransformStamped>}}},
+    {"-suj", "PositionCartesianLocal", dvrk_topics_rate::medium,
+     {{"/position_cartesian_local_current", &dvrk::add_event_write<prmPositionCartesianGet, geometry_msgs::Pose>},
+      {"/position_cartesian_local_current", &dvrk::add_event_write<prmPositionCartesianGet, geometry_msgs::PoseStamped>},
+      {"/local/measured_cp", &dvrk::add_read<prmPositionCartesianGet, geometry_msgs::TransformStamped>}}}
+};
+
+void dvrk::add_topics_suj(dvrk::bridge & bridge,
                           const std::string & ros_namespace,
                           const std::string & arm_name,
-                          const dvrk_topics_version::version version)
+                          const dvrk::topics_versions & versions)
 {
-    // events
-    switch (version) {
-    case dvrk_topics_version::v1_3_0:
-        bridge.AddPublisherFromEventWrite<prmPositionCartesianGet, geometry_msgs::Pose>
-            (arm_name + "-suj", "PositionCartesian",
-             ros_namespace + "/position_cartesian_current");
-        bridge.AddPublisherFromEventWrite<prmPositionCartesianGet, geometry_msgs::Pose>
-            (arm_name + "-suj", "PositionCartesianLocal",
-             ros_namespace + "/position_cartesian_local_current");
-        break;
-    case dvrk_topics_version::crtk_alpha:
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (arm_name + "-suj", "GetStateJoint",
-             ros_namespace + "/measured_js");
-        bridge.AddSubscriberToCommandWrite<prmPositionJointSet, sensor_msgs::JointState>
-            (arm_name + "-suj", "SetPositionJoint",
-             ros_namespace + "/servo_jp");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::TransformStamped>
-            (arm_name + "-suj", "PositionCartesianLocal",
-             ros_namespace + "/local/measured_cp");
-        bridge.AddPublisherFromCommandRead<prmPositionCartesianGet, geometry_msgs::TransformStamped>
-            (arm_name + "-suj", "PositionCartesian",
-             ros_namespace + "/measured_cp");
-        break;
-    default:
-        bridge.AddPublisherFromCommandRead<prmStateJoint, sensor_msgs::JointState>
-            (arm_name + "-suj", "GetStateJoint",
-             ros_namespace + "/state_joint_current");
-        bridge.AddSubscriberToCommandWrite<prmPositionJointSet, sensor_msgs::JointState>
-            (arm_name + "-suj", "SetPositionJoint",
-             ros_namespace + "/set_position_joint");
-        bridge.AddPublisherFromEventWrite<prmPositionCartesianGet, geometry_msgs::PoseStamped>
-            (arm_name + "-suj", "PositionCartesian",
-             ros_namespace + "/position_cartesian_current");
-        bridge.AddPublisherFromEventWrite<prmPositionCartesianGet, geometry_msgs::PoseStamped>
-            (arm_name + "-suj", "PositionCartesianLocal",
-             ros_namespace + "/position_cartesian_local_current");
-        break;
-    }
+    // read, write and events
+    dvrk::add_topics_from_table(bridge, ros_namespace,
+                                arm_name, versions,
+                                suj_topics);
 
     // messages
     bridge.AddLogFromEventWrite(arm_name + "-suj-log", "Error",
@@ -725,19 +748,22 @@ void dvrk::connect_bridge_suj(const std::string & bridge_name,
                               suj_component_name, arm_name);
 }
 
-void dvrk::add_topics_io(mtsROSBridge & bridge,
+void dvrk::add_topics_io(dvrk::bridge & bridge,
                          const std::string & ros_namespace,
-                         const dvrk_topics_version::version CMN_UNUSED(version))
+                         const dvrk::topics_versions & CMN_UNUSED(versions))
 {
     bridge.AddPublisherFromCommandRead<mtsIntervalStatistics, cisst_msgs::mtsIntervalStatistics>
         ("io", "GetPeriodStatistics",
-         ros_namespace + "/period_statistics");
+         ros_namespace + "/period_statistics",
+         dvrk_topics_rate::slow);
     bridge.AddPublisherFromCommandRead<mtsIntervalStatistics, cisst_msgs::mtsIntervalStatistics>
         ("io", "GetPeriodStatisticsRead",
-         ros_namespace + "/period_statistics_read");
+         ros_namespace + "/period_statistics_read",
+         dvrk_topics_rate::slow);
     bridge.AddPublisherFromCommandRead<mtsIntervalStatistics, cisst_msgs::mtsIntervalStatistics>
         ("io", "GetPeriodStatisticsWrite",
-         ros_namespace + "/period_statistics_write");
+         ros_namespace + "/period_statistics_write",
+         dvrk_topics_rate::slow);
 }
 
 void dvrk::connect_bridge_io(const std::string & bridge_name,
@@ -748,10 +774,10 @@ void dvrk::connect_bridge_io(const std::string & bridge_name,
                               io_component_name, "Configuration");
 }
 
-void dvrk::add_topics_io(mtsROSBridge & bridge,
+void dvrk::add_topics_io(dvrk::bridge & bridge,
                          const std::string & ros_namespace,
                          const std::string & arm_name,
-                         const dvrk_topics_version::version CMN_UNUSED(version))
+                         const dvrk::topics_versions & CMN_UNUSED(versions))
 {
     bridge.AddPublisherFromCommandRead<vctDoubleVec, sensor_msgs::JointState>
         (arm_name + "-io", "GetAnalogInputPosSI",
@@ -773,10 +799,32 @@ void dvrk::connect_bridge_io(const std::string & bridge_name,
                               io_component_name, arm_name);
 }
 
-void dvrk::add_tf_arm(mtsROSBridge & tf_bridge,
+void dvrk::add_topics_io_capture(dvrk::bridge & bridge,
+                                 const std::string & ros_namespace,
+                                 const std::string & arm_name,
+                                 const size_t samples_per_chunk,
+                                 const size_t buffer_size)
+{
+    bridge.AddIOCapturePublisher(arm_name + "-io-capture",
+                                 ros_namespace + "/capture",
+                                 samples_per_chunk, buffer_size);
+}
+
+void dvrk::connect_bridge_io_capture(const std::string & bridge_name,
+                                     const std::string & io_component_name,
+                                     const std::string & arm_name)
+{
+    mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+    componentManager->Connect(bridge_name, arm_name + "-io-capture",
+                              io_component_name, arm_name);
+    componentManager->Connect(bridge_name, arm_name + "-io-capture-run",
+                              io_component_name, "ExecOut");
+}
+
+void dvrk::add_tf_arm(dvrk::bridge & tf_bridge,
                       const std::string & arm_name)
 {
-    tf_bridge.Addtf2BroadcasterFromCommandRead(arm_name, "GetPositionCartesian");
+    tf_bridge.AddTfPublisher(arm_name, "GetPositionCartesian");
 }
 
 void dvrk::connect_tf_arm(const std::string & tf_bridge_name,
@@ -789,10 +837,10 @@ void dvrk::connect_tf_arm(const std::string & tf_bridge_name,
                               arm_component_name, arm_interface_name);
 }
 
-void dvrk::add_tf_suj(mtsROSBridge & tf_bridge,
+void dvrk::add_tf_suj(dvrk::bridge & tf_bridge,
                       const std::string & arm_name)
 {
-    tf_bridge.Addtf2BroadcasterFromCommandRead(arm_name + "-suj", "GetPositionCartesian");
+    tf_bridge.AddTfPublisher(arm_name + "-suj", "GetPositionCartesian", true);
 }
 
 void dvrk::connect_tf_suj(const std::string & tf_bridge_name,
@@ -0,0 +1,126 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-13
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <dvrk_utilities/dvrk_arm_state_publisher.h>
+
+dvrk::arm_state_publisher::arm_state_publisher(const std::string & topic_name,
+                                               const dvrk_topics_rate::rate rate,
+                                               const uint32_t queue_size):
+    publisher_base(topic_name, rate, queue_size),
+    mNumberOfRereads(0)
+{
+}
+
+void dvrk::arm_state_publisher::Advertise(ros::NodeHandle & node_handle)
+{
+    mPublisher = node_handle.advertise<dvrk_robot::ArmState>(mTopicName, mQueueSize);
+}
+
+bool dvrk::arm_state_publisher::AddFunctions(mtsInterfaceRequired * interface_required)
+{
+    return interface_required->AddFunction("GetStateJoint", Arm.GetStateJoint)
+        && interface_required->AddFunction("GetStateJointDesired", Arm.GetStateJointDesired)
+        && interface_required->AddFunction("GetPositionCartesian", Arm.GetPositionCartesian)
+        && interface_required->AddFunction("GetPositionCartesianDesired", Arm.GetPositionCartesianDesired)
+        && interface_required->AddFunction("GetPositionCartesianLocal", Arm.GetPositionCartesianLocal)
+        && interface_required->AddFunction("GetPositionCartesianLocalDesired", Arm.GetPositionCartesianLocalDesired)
+        && interface_required->AddFunction("GetVelocityCartesian", Arm.GetVelocityCartesian)
+        && interface_required->AddFunction("GetWrenchBody", Arm.GetWrenchBody)
+        && interface_required->AddFunction("GetJacobianBody", Arm.GetJacobianBody, MTS_OPTIONAL)
+        && interface_required->AddFunction("GetJacobianSpatial", Arm.GetJacobianSpatial, MTS_OPTIONAL)
+        && interface_required->AddFunction("GetStateGripper", Arm.GetStateGripper, MTS_OPTIONAL);
+}
+
+bool dvrk::arm_state_publisher::Read(void)
+{
+    // measured_js first, its timestamp is compared to the last
+    // sample read (measured_cp)
+    if (!Arm.GetStateJoint(mMeasuredJS)
+        || !Arm.GetStateJointDesired(mSetpointJS)
+        || !Arm.GetPositionCartesianDesired(mSetpointCP)
+        || !Arm.GetPositionCartesianLocal(mLocalMeasuredCP)
+        || !Arm.GetPositionCartesianLocalDesired(mLocalSetpointCP)
+        || !Arm.GetVelocityCartesian(mMeasuredCV)
+        || !Arm.GetWrenchBody(mBodyMeasuredCF)) {
+        return false;
+    }
+    // optional commands, if provided they must succeed or the
+    // message would contain a value from a previous read
+    if ((Arm.GetJacobianBody.IsValid() && !Arm.GetJacobianBody(mBodyJacobian))
+        || (Arm.GetJacobianSpatial.IsValid() && !Arm.GetJacobianSpatial(mSpatialJacobian))
+        || (Arm.GetStateGripper.IsValid() && !Arm.GetStateGripper(mGripperMeasuredJS))) {
+        return false;
+    }
+    return Arm.GetPositionCartesian(mMeasuredCP);
+}
+
+bool dvrk::arm_state_publisher::Execute(void)
+{
+    if (mLazy && (mPublisher.getNumSubscribers() == 0)) {
+        return true;
+    }
+
+    // read until the first and last samples are from the same cycle
+    size_t reads = 0;
+    do {
+        if (!Read()) {
+            return false;
+        }
+        ++reads;
+    } while ((mMeasuredJS.Timestamp() != mMeasuredCP.Timestamp())
+             && (reads < MaximumReads));
+    mNumberOfRereads += (reads - 1);
+
+    // convert, use a new message for each publication so subscribers
+    // in the same process can keep the shared pointer
+    dvrk_robot::ArmState::Ptr rosData(new dvrk_robot::ArmState);
+    bool result = mtsCISSTToROS(mMeasuredJS, rosData->measured_js, mTopicName)
+        && mtsCISSTToROS(mSetpointJS, rosData->setpoint_js, mTopicName);
+    rosData->header.stamp = rosData->measured_js.header.stamp;
+
+    result = result && mtsCISSTToROS(mMeasuredCP, mTransformStamped, mTopicName);
+    rosData->measured_cp = mTransformStamped.transform;
+    result = result && mtsCISSTToROS(mSetpointCP, mTransformStamped, mTopicName);
+    rosData->setpoint_cp = mTransformStamped.transform;
+    result = result && mtsCISSTToROS(mLocalMeasuredCP, mTransformStamped, mTopicName);
+    rosData->local_measured_cp = mTransformStamped.transform;
+    result = result && mtsCISSTToROS(mLocalSetpointCP, mTransformStamped, mTopicName);
+    rosData->local_setpoint_cp = mTransformStamped.transform;
+
+    result = result && mtsCISSTToROS(mMeasuredCV, mTwistStamped, mTopicName);
+    rosData->measured_cv = mTwistStamped.twist;
+    result = result && mtsCISSTToROS(mBodyMeasuredCF, mWrenchStamped, mTopicName);
+    rosData->body_measured_cf = mWrenchStamped.wrench;
+
+    if (Arm.GetJacobianBody.IsValid()) {
+        result = result && mtsCISSTToROS(mBodyJacobian, rosData->body_jacobian, mTopicName);
+    }
+    if (Arm.GetJacobianSpatial.IsValid()) {
+        result = result && mtsCISSTToROS(mSpatialJacobian, rosData->spatial_jacobian, mTopicName);
+    }
+    if (Arm.GetStateGripper.IsValid()) {
+        result = result && mtsCISSTToROS(mGripperMeasuredJS, rosData->gripper_measured_js, mTopicName);
+    }
+
+    if (!result) {
+        return false;
+    }
+    mPublisher.publish(rosData);
+    RecordLatency(mMeasuredJS.Timestamp());
+    return true;
+}
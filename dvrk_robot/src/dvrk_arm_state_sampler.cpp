@@ -0,0 +1,78 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-24
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <string.h>
+#include <algorithm>
+
+#include <dvrk_utilities/dvrk_arm_state_sampler.h>
+
+namespace {
+    // copy up to size elements, the destination is already zeroed
+    void copy_joints(const vctDoubleVec & source, const size_t size, double * destination)
+    {
+        std::copy(source.begin(), source.begin() + std::min(size, source.size()), destination);
+    }
+}
+
+bool dvrk::arm_state_sampler::AddFunctions(mtsInterfaceRequired * interface_required)
+{
+    return interface_required->AddFunction("GetStateJoint", Arm.GetStateJoint)
+        && interface_required->AddFunction("GetStateJointDesired", Arm.GetStateJointDesired)
+        && interface_required->AddFunction("GetPositionCartesian", Arm.GetPositionCartesian)
+        && interface_required->AddFunction("GetPositionCartesianDesired", Arm.GetPositionCartesianDesired)
+        && interface_required->AddFunction("GetWrenchBody", Arm.GetWrenchBody);
+}
+
+void dvrk::arm_state_sampler::CopyFrame(const vctFrm3 & frame, double * destination)
+{
+    destination[0] = frame.Translation()[0];
+    destination[1] = frame.Translation()[1];
+    destination[2] = frame.Translation()[2];
+    for (size_t row = 0; row < 3; ++row) {
+        for (size_t col = 0; col < 3; ++col) {
+            destination[3 + 3 * row + col] = frame.Rotation().Element(row, col);
+        }
+    }
+}
+
+bool dvrk::arm_state_sampler::Sample(dvrk_arm_state & state)
+{
+    const bool result = Arm.GetStateJoint(mMeasuredJS)
+        && Arm.GetStateJointDesired(mSetpointJS)
+        && Arm.GetPositionCartesian(mMeasuredCP)
+        && Arm.GetPositionCartesianDesired(mSetpointCP)
+        && Arm.GetWrenchBody(mBodyMeasuredCF);
+
+    memset(&state, 0, sizeof(dvrk_arm_state));
+    state.Timestamp = mMeasuredJS.Timestamp();
+    state.Valid = result && mMeasuredJS.Valid() && mMeasuredCP.Valid();
+    const size_t joints = std::min(mMeasuredJS.Position().size(),
+                                   static_cast<size_t>(DVRK_ARM_STATE_MAXIMUM_JOINTS));
+    state.NumberOfJoints = joints;
+    copy_joints(mMeasuredJS.Position(), joints, state.MeasuredPosition);
+    copy_joints(mMeasuredJS.Velocity(), joints, state.MeasuredVelocity);
+    copy_joints(mMeasuredJS.Effort(), joints, state.MeasuredEffort);
+    copy_joints(mSetpointJS.Position(), joints, state.SetpointPosition);
+    copy_joints(mSetpointJS.Effort(), joints, state.SetpointEffort);
+    CopyFrame(mMeasuredCP.Position(), state.MeasuredCP);
+    CopyFrame(mSetpointCP.Position(), state.SetpointCP);
+    std::copy(mBodyMeasuredCF.F().Pointer(),
+              mBodyMeasuredCF.F().Pointer() + 6,
+              state.BodyMeasuredCF);
+    return result;
+}
@@ -0,0 +1,274 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-06-05
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdint.h>
+
+#include <dvrk_utilities/dvrk_async_log_channel.h>
+
+namespace {
+    // last channel and buffer used by this thread, avoids the lookup
+    // (and lock) for each line
+    struct thread_cache {
+        const void * Channel;
+        void * Buffer;
+    };
+    thread_local thread_cache cache = {0, 0};
+
+    // copy to and from the ring buffer, handles wrap around
+    void ring_write(char * data, const size_t size, const size_t position,
+                    const char * source, const size_t count)
+    {
+        const size_t start = position % size;
+        const size_t first = std::min(count, size - start);
+        memcpy(data + start, source, first);
+        memcpy(data, source + first, count - first);
+    }
+
+    void ring_read(const char * data, const size_t size, const size_t position,
+                   char * destination, const size_t count)
+    {
+        const size_t start = position % size;
+        const size_t first = std::min(count, size - start);
+        memcpy(destination, data + start, first);
+        memcpy(destination + first, data, count - first);
+    }
+}
+
+dvrk::async_log_channel::thread_buffer::thread_buffer(const size_t size):
+    Data(new char[size]),
+    Size(size),
+    Head(0),
+    Tail(0),
+    LineSize(0)
+{
+}
+
+dvrk::async_log_channel::thread_buffer::~thread_buffer()
+{
+    delete[] Data;
+}
+
+dvrk::async_log_channel::stream_buffer::stream_buffer(async_log_channel * channel):
+    mChannel(channel)
+{
+    // no put area, every write goes to overflow or xsputn
+    setp(0, 0);
+}
+
+dvrk::async_log_channel::stream_buffer::int_type
+dvrk::async_log_channel::stream_buffer::overflow(int_type character)
+{
+    if (!traits_type::eq_int_type(character, traits_type::eof())) {
+        const char value = traits_type::to_char_type(character);
+        mChannel->Append(&value, 1);
+    }
+    return traits_type::not_eof(character);
+}
+
+std::streamsize dvrk::async_log_channel::stream_buffer::xsputn(const char * characters,
+                                                               std::streamsize count)
+{
+    mChannel->Append(characters, count);
+    return count;
+}
+
+int dvrk::async_log_channel::stream_buffer::sync(void)
+{
+    // partial lines are committed on flush
+    mChannel->Commit(mChannel->Buffer());
+    return 0;
+}
+
+dvrk::async_log_channel::async_log_channel(const std::string & file_name,
+                                           const size_t buffer_size_per_thread,
+                                           const double & flush_period_in_seconds):
+    mFileName(file_name),
+    mBufferSize(buffer_size_per_thread),
+    mFlushPeriod(flush_period_in_seconds),
+    mStreamBuffer(this),
+    mStream(&mStreamBuffer),
+    mDropped(0),
+    mDroppedReported(0),
+    mRunning(false)
+{
+    mEntry.reserve(MaximumLineSize);
+    mWriterThreadSettings.Policy = thread_settings::POLICY_OTHER;
+    mWriterThreadSettings.SetNice = true;
+    mWriterThreadSettings.Nice = 10;
+}
+
+dvrk::async_log_channel::~async_log_channel()
+{
+    Stop();
+    const BuffersType::iterator end = mBuffers.end();
+    BuffersType::iterator buffer;
+    for (buffer = mBuffers.begin();
+         buffer != end;
+         ++buffer) {
+        delete buffer->second;
+    }
+    mBuffers.clear();
+}
+
+bool dvrk::async_log_channel::Start(void)
+{
+    if (mRunning) {
+        return true;
+    }
+    mFile.open(mFileName.c_str());
+    if (!mFile.is_open()) {
+        std::cerr << "async_log_channel: failed to open \"" << mFileName << "\"" << std::endl;
+        return false;
+    }
+    mRunning = true;
+    mWriterThread.Create<async_log_channel, void *>(this, &async_log_channel::Run, 0, "dVRKLog");
+    return true;
+}
+
+void dvrk::async_log_channel::Stop(void)
+{
+    if (!mRunning) {
+        return;
+    }
+    mRunning = false;
+    mWriterSignal.Raise();
+    mWriterThread.Wait();
+    // lines logged while the writer was stopping
+    Drain();
+    mFile.close();
+}
+
+dvrk::async_log_channel::thread_buffer * dvrk::async_log_channel::Buffer(void)
+{
+    if (cache.Channel == this) {
+        return static_cast<thread_buffer *>(cache.Buffer);
+    }
+    // first log from this thread, or thread alternating between
+    // channels
+    thread_buffer * result;
+    mBuffersMutex.Lock();
+    const std::thread::id id = std::this_thread::get_id();
+    const BuffersType::iterator found = mBuffers.find(id);
+    if (found == mBuffers.end()) {
+        result = new thread_buffer(mBufferSize);
+        mBuffers[id] = result;
+    } else {
+        result = found->second;
+    }
+    mBuffersMutex.Unlock();
+    cache.Channel = this;
+    cache.Buffer = result;
+    return result;
+}
+
+void dvrk::async_log_channel::Append(const char * characters, const size_t count)
+{
+    thread_buffer * buffer = Buffer();
+    for (size_t index = 0; index < count; ++index) {
+        // truncate long lines but keep the end of line
+        if (buffer->LineSize < MaximumLineSize) {
+            buffer->Line[buffer->LineSize] = characters[index];
+            ++(buffer->LineSize);
+        }
+        if (characters[index] == '\n') {
+            Commit(buffer);
+        }
+    }
+}
+
+void dvrk::async_log_channel::Commit(thread_buffer * buffer)
+{
+    if (buffer->LineSize == 0) {
+        return;
+    }
+    const uint32_t size = buffer->LineSize;
+    const size_t needed = sizeof(size) + size;
+    const size_t head = buffer->Head.load(std::memory_order_relaxed);
+    const size_t tail = buffer->Tail.load(std::memory_order_acquire);
+    if ((buffer->Size - (head - tail)) < needed) {
+        ++mDropped;
+    } else {
+        ring_write(buffer->Data, buffer->Size, head,
+                   reinterpret_cast<const char *>(&size), sizeof(size));
+        ring_write(buffer->Data, buffer->Size, head + sizeof(size),
+                   buffer->Line, size);
+        buffer->Head.store(head + needed, std::memory_order_release);
+    }
+    buffer->LineSize = 0;
+}
+
+void dvrk::async_log_channel::Drain(void)
+{
+    // copy the list so threads logging for the first time don't wait
+    // for the file
+    std::list<thread_buffer *> buffers;
+    mBuffersMutex.Lock();
+    const BuffersType::const_iterator buffersEnd = mBuffers.end();
+    BuffersType::const_iterator iter;
+    for (iter = mBuffers.begin();
+         iter != buffersEnd;
+         ++iter) {
+        buffers.push_back(iter->second);
+    }
+    mBuffersMutex.Unlock();
+
+    const std::list<thread_buffer *>::const_iterator end = buffers.end();
+    std::list<thread_buffer *>::const_iterator buffer;
+    for (buffer = buffers.begin();
+         buffer != end;
+         ++buffer) {
+        thread_buffer * current = *buffer;
+        size_t tail = current->Tail.load(std::memory_order_relaxed);
+        const size_t head = current->Head.load(std::memory_order_acquire);
+        while (tail != head) {
+            uint32_t size;
+            ring_read(current->Data, current->Size, tail,
+                      reinterpret_cast<char *>(&size), sizeof(size));
+            mEntry.resize(size);
+            ring_read(current->Data, current->Size, tail + sizeof(size),
+                      &(mEntry[0]), size);
+            mFile << mEntry;
+            tail += sizeof(size) + size;
+        }
+        current->Tail.store(tail, std::memory_order_release);
+    }
+
+    const size_t dropped = mDropped.load();
+    if (dropped != mDroppedReported) {
+        mFile << "async_log_channel: " << (dropped - mDroppedReported)
+              << " line(s) dropped, buffer full (total " << dropped << ")" << std::endl;
+        mDroppedReported = dropped;
+    }
+    mFile.flush();
+}
+
+void * dvrk::async_log_channel::Run(void * CMN_UNUSED(argument))
+{
+    std::string message;
+    if (!apply_thread_settings(mWriterThreadSettings, message)) {
+        std::cerr << "async_log_channel: " << message << std::endl;
+    }
+    while (mRunning) {
+        mWriterSignal.Wait(mFlushPeriod);
+        Drain();
+    }
+    return 0;
+}
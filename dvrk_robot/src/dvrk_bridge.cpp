@@ -0,0 +1,593 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-02
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <fnmatch.h>
+#include <algorithm>
+
+#include <dvrk_utilities/dvrk_bridge.h>
+#include <dvrk_utilities/dvrk_arm_state_publisher.h>
+#include <dvrk_utilities/dvrk_io_capture.h>
+#include <dvrk_utilities/dvrk_tf_publisher.h>
+#include <dvrk_utilities/dvrk_compact_joint_state.h>
+#include <dvrk_utilities/dvrk_jacobian_service.h>
+#include <dvrk_utilities/dvrk_timing_monitor.h>
+
+#include <diagnostic_msgs/DiagnosticArray.h>
+
+namespace {
+    // node handle for the subscribers and services added using the
+    // mtsROSBridge API, uses the bridges' callback queue
+    ros::NodeHandle * create_node_handle(void)
+    {
+        ros::NodeHandle * nodeHandle = new ros::NodeHandle;
+        nodeHandle->setCallbackQueue(&dvrk::bridge::CallbackQueue());
+        return nodeHandle;
+    }
+}
+
+ros::CallbackQueue & dvrk::bridge::CallbackQueue(void)
+{
+    static ros::CallbackQueue queue;
+    return queue;
+}
+
+dvrk::bridge::bridge(const std::string & component_name,
+                     const double & period_in_seconds,
+                     const bool spin,
+                     const bool catch_signal):
+    // spin is handled by dvrk::bridge, see Run
+    mtsROSBridge(component_name, period_in_seconds, false, catch_signal, create_node_handle()),
+    mSpin(spin),
+    mLazy(true),
+    mDeferAdvertisement(false),
+    mTfPublisher(0)
+{
+    // by default, all classes use the bridge period
+    RateClass rate;
+    rate.Period = period_in_seconds;
+    rate.Next = 0.0;
+    rate.Due = true;
+    mRates.resize(dvrk_topics_rate::rateVectorString().size(), rate);
+
+    mTrigger.Enabled = false;
+    mTrigger.Decimation = 1;
+    mTrigger.Counter = 0;
+
+    mLatencyStatistics.Enabled = false;
+    mLatencyStatistics.Period = 1.0;
+    mLatencyStatistics.Next = 0.0;
+
+    // callbacks are only processed by spinning bridges
+    mNodeHandle.setCallbackQueue(&CallbackQueue());
+}
+
+dvrk::bridge::~bridge()
+{
+    const PublishersType::iterator end = mPublishers.end();
+    PublishersType::iterator iter;
+    for (iter = mPublishers.begin();
+         iter != end;
+         ++iter) {
+        delete *iter;
+    }
+    mPublishers.clear();
+
+    const LatestCommandGroupsType::iterator groupsEnd = mLatestCommandGroups.end();
+    LatestCommandGroupsType::iterator group;
+    for (group = mLatestCommandGroups.begin();
+         group != groupsEnd;
+         ++group) {
+        delete group->second;
+    }
+    mLatestCommandGroups.clear();
+
+    const SubscribersType::iterator subscribersEnd = mSubscribers.end();
+    SubscribersType::iterator subscriber;
+    for (subscriber = mSubscribers.begin();
+         subscriber != subscribersEnd;
+         ++subscriber) {
+        delete *subscriber;
+    }
+    mSubscribers.clear();
+
+    const ServicesType::iterator servicesEnd = mServices.end();
+    ServicesType::iterator service;
+    for (service = mServices.begin();
+         service != servicesEnd;
+         ++service) {
+        delete *service;
+    }
+    mServices.clear();
+
+    const ReadSourcesType::iterator sourcesEnd = mReadSources.end();
+    ReadSourcesType::iterator source;
+    for (source = mReadSources.begin();
+         source != sourcesEnd;
+         ++source) {
+        delete source->second;
+    }
+    mReadSources.clear();
+
+    const FunctionsWriteType::iterator functionsEnd = mFunctionsWrite.end();
+    FunctionsWriteType::iterator function;
+    for (function = mFunctionsWrite.begin();
+         function != functionsEnd;
+         ++function) {
+        delete function->second;
+    }
+    mFunctionsWrite.clear();
+}
+
+void dvrk::bridge::Startup(void)
+{
+    mtsROSBridge::Startup();
+    // deferred advertisements
+    const PublishersType::iterator end = mDeferredPublishers.end();
+    PublishersType::iterator iter;
+    for (iter = mDeferredPublishers.begin();
+         iter != end;
+         ++iter) {
+        (*iter)->Advertise(mNodeHandle);
+    }
+    mDeferredPublishers.clear();
+
+    // Startup is called from the bridge's thread
+    std::string message;
+    if (!apply_thread_settings(mThreadSettings, message)) {
+        CMN_LOG_CLASS_INIT_ERROR << "Startup: " << this->GetName()
+                                 << ", " << message << std::endl;
+    } else {
+        CMN_LOG_CLASS_INIT_VERBOSE << "Startup: " << this->GetName()
+                                   << ", thread settings " << mThreadSettings.HumanReadable() << std::endl;
+    }
+}
+
+void dvrk::bridge::Run(void)
+{
+    // queued commands and events, publishers added using the
+    // mtsROSBridge API
+    mtsROSBridge::Run();
+
+    if (!mTrigger.Enabled) {
+        Publish();
+        if (!mSpin) {
+            return;
+        }
+    }
+
+    // wait until the end of this period for either the trigger
+    // signal (publish) or ROS callbacks (spin), both wake up as soon
+    // as there is something to do.  Keep a small margin so the task
+    // can sleep until the next period without overrunning it.
+    const osaTimeServer & timeServer = mtsManagerLocal::GetInstance()->GetTimeServer();
+    double now = timeServer.GetRelativeTime();
+    const double end = now + 0.95 * this->GetPeriodicity();
+    while (now < end) {
+        if (mTrigger.Enabled) {
+            // if we also need to spin, don't wait too long for the trigger
+            const double timeout = mSpin ? std::min(end - now, 1.0 * cmn_ms) : (end - now);
+            if (mTrigger.Signal.Wait(timeout)) {
+                Publish();
+            }
+            if (mSpin) {
+                CallbackQueue().callAvailable();
+            }
+        } else {
+            CallbackQueue().callAvailable(ros::WallDuration(end - now));
+        }
+        now = timeServer.GetRelativeTime();
+    }
+}
+
+void dvrk::bridge::Publish(void)
+{
+    // find which rate classes are due, use half a bridge period (or
+    // fast period if shorter) as tolerance so the jitter on the
+    // bridge thread doesn't make us skip a cycle
+    const double now = mtsManagerLocal::GetInstance()->GetTimeServer().GetRelativeTime();
+    const double tolerance = 0.5 * std::min(this->GetPeriodicity(),
+                                            mRates[dvrk_topics_rate::fast].Period);
+    const std::vector<RateClass>::iterator ratesEnd = mRates.end();
+    std::vector<RateClass>::iterator rate;
+    for (rate = mRates.begin();
+         rate != ratesEnd;
+         ++rate) {
+        rate->Due = ((now + tolerance) >= rate->Next);
+        if (rate->Due) {
+            rate->Next += rate->Period;
+            // don't try to catch up if we're late
+            if (rate->Next < now) {
+                rate->Next = now + rate->Period;
+            }
+        }
+    }
+
+    // commands shared by multiple publishers are read at most once
+    // per cycle
+    const ReadSourcesType::iterator sourcesEnd = mReadSources.end();
+    ReadSourcesType::iterator source;
+    for (source = mReadSources.begin();
+         source != sourcesEnd;
+         ++source) {
+        source->second->Reset();
+    }
+
+    // publish
+    const PublishersType::iterator end = mPublishers.end();
+    PublishersType::iterator iter;
+    for (iter = mPublishers.begin();
+         iter != end;
+         ++iter) {
+        if (mRates[(*iter)->Rate()].Due) {
+            (*iter)->Execute();
+        }
+    }
+
+    if (mLatencyStatistics.Enabled) {
+        PublishLatencyStatistics(now);
+    }
+}
+
+void dvrk::bridge::PublishLatencyStatistics(const double & now)
+{
+    if (now < mLatencyStatistics.Next) {
+        return;
+    }
+    mLatencyStatistics.Next = now + mLatencyStatistics.Period;
+
+    const bool publish = (mLatencyStatistics.Publisher.getNumSubscribers() > 0);
+    diagnostic_msgs::DiagnosticArray::Ptr rosData(new diagnostic_msgs::DiagnosticArray);
+    const PublishersType::iterator end = mPublishers.end();
+    PublishersType::iterator iter;
+    for (iter = mPublishers.begin();
+         iter != end;
+         ++iter) {
+        latency_histogram & latency = (*iter)->Latency();
+        if (publish && (latency.Count() > 0)) {
+            diagnostic_msgs::DiagnosticStatus status;
+            status.level = diagnostic_msgs::DiagnosticStatus::OK;
+            status.name = (*iter)->TopicName();
+            status.message = "publish latency (ms)";
+            diagnostic_msgs::KeyValue value;
+            value.key = "count";
+            value.value = std::to_string(latency.Count());
+            status.values.push_back(value);
+            value.key = "p50";
+            value.value = std::to_string(latency.Percentile(0.5) * 1000.0);
+            status.values.push_back(value);
+            value.key = "p90";
+            value.value = std::to_string(latency.Percentile(0.9) * 1000.0);
+            status.values.push_back(value);
+            value.key = "p99";
+            value.value = std::to_string(latency.Percentile(0.99) * 1000.0);
+            status.values.push_back(value);
+            value.key = "max";
+            value.value = std::to_string(latency.Max() * 1000.0);
+            status.values.push_back(value);
+            rosData->status.push_back(status);
+        }
+        latency.Reset();
+    }
+    if (publish) {
+        rosData->header.stamp = ros::Time::now();
+        mLatencyStatistics.Publisher.publish(rosData);
+    }
+}
+
+bool dvrk::bridge::AddArmStatePublisher(const std::string & interface_required_name,
+                                        const std::string & topic_name,
+                                        const dvrk_topics_rate::rate rate,
+                                        const uint32_t queue_size)
+{
+    mtsInterfaceRequired * interfaceRequired = this->AddInterfaceRequired(interface_required_name);
+    if (!interfaceRequired) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddArmStatePublisher: failed to create required interface \""
+                                 << interface_required_name << "\"" << std::endl;
+        return false;
+    }
+    arm_state_publisher * newPublisher =
+        new arm_state_publisher(topic_name, rate, queue_size);
+    if (!newPublisher->AddFunctions(interfaceRequired)) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddArmStatePublisher: failed to add functions for topic \""
+                                 << topic_name << "\"" << std::endl;
+        delete newPublisher;
+        return false;
+    }
+    AddPublisher(newPublisher);
+    return true;
+}
+
+bool dvrk::bridge::AddIOCapturePublisher(const std::string & interface_required_name,
+                                         const std::string & topic_name,
+                                         const size_t samples_per_chunk,
+                                         const size_t buffer_size)
+{
+    mtsInterfaceRequired * interfaceRequired = this->AddInterfaceRequired(interface_required_name);
+    mtsInterfaceRequired * runInterfaceRequired = this->AddInterfaceRequired(interface_required_name + "-run");
+    if (!interfaceRequired || !runInterfaceRequired) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddIOCapturePublisher: failed to create required interfaces \""
+                                 << interface_required_name << "\"" << std::endl;
+        return false;
+    }
+    io_capture_publisher * newPublisher =
+        new io_capture_publisher(topic_name, samples_per_chunk, buffer_size);
+    if (!newPublisher->AddFunctions(interfaceRequired, runInterfaceRequired)) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddIOCapturePublisher: failed to add functions for topic \""
+                                 << topic_name << "\"" << std::endl;
+        delete newPublisher;
+        return false;
+    }
+    AddPublisher(newPublisher);
+    return true;
+}
+
+bool dvrk::bridge::AddJointStateDescriptionPublisher(const std::string & interface_required_name,
+                                                     const std::string & function_name,
+                                                     const std::string & topic_name,
+                                                     const dvrk_topics_rate::rate rate)
+{
+    command_read_source<prmStateJoint> * source =
+        ReadSource<prmStateJoint>(interface_required_name, function_name);
+    if (!source) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddJointStateDescriptionPublisher: failed to create function \""
+                                 << function_name << "\" for topic \""
+                                 << topic_name << "\"" << std::endl;
+        return false;
+    }
+    AddPublisher(new joint_state_description_publisher(source, topic_name, rate));
+    return true;
+}
+
+bool dvrk::bridge::AddJacobianService(const std::string & interface_required_name,
+                                      const std::string & service_name)
+{
+    mtsInterfaceRequired * interfaceRequired = this->AddInterfaceRequired(interface_required_name);
+    if (!interfaceRequired) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddJacobianService: failed to create required interface \""
+                                 << interface_required_name << "\"" << std::endl;
+        return false;
+    }
+    jacobian_service * newService = new jacobian_service(service_name);
+    if (!newService->AddFunctions(interfaceRequired)) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddJacobianService: failed to add functions for service \""
+                                 << service_name << "\"" << std::endl;
+        delete newService;
+        return false;
+    }
+    newService->Advertise(mNodeHandle);
+    mServices.push_back(newService);
+    return true;
+}
+
+bool dvrk::bridge::AddTfPublisher(const std::string & interface_required_name,
+                                  const std::string & function_name,
+                                  const bool is_static)
+{
+    command_read_source<prmPositionCartesianGet> * source =
+        ReadSource<prmPositionCartesianGet>(interface_required_name, function_name);
+    if (!source) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddTfPublisher: failed to create function \""
+                                 << function_name << "\" for required interface \""
+                                 << interface_required_name << "\"" << std::endl;
+        return false;
+    }
+    if (!mTfPublisher) {
+        mTfPublisher = new tf_publisher(dvrk_topics_rate::fast);
+        AddPublisher(mTfPublisher);
+    }
+    mTfPublisher->AddFrame(source, is_static);
+    return true;
+}
+
+void dvrk::bridge::AddPublisher(publisher_base * publisher)
+{
+    publisher->SetLazy(mLazy);
+    if (mDeferAdvertisement && (publisher->Rate() != dvrk_topics_rate::fast)) {
+        mDeferredPublishers.push_back(publisher);
+    } else {
+        publisher->Advertise(mNodeHandle);
+    }
+    mPublishers.push_back(publisher);
+}
+
+void dvrk::bridge::AddLatencyStatisticsPublisher(const std::string & topic_name,
+                                                 const double & period_in_seconds)
+{
+    mLatencyStatistics.Publisher =
+        mNodeHandle.advertise<diagnostic_msgs::DiagnosticArray>(topic_name, 1);
+    mLatencyStatistics.Period = period_in_seconds;
+    mLatencyStatistics.Next = 0.0;
+    mLatencyStatistics.Enabled = true;
+}
+
+void dvrk::bridge::AddTimingStatisticsPublisher(timing_monitor * monitor,
+                                                const std::string & topic_name,
+                                                const double & period_in_seconds)
+{
+    AddPublisher(new timing_statistics_publisher(monitor, topic_name, period_in_seconds));
+}
+
+void dvrk::bridge::SetRatePeriod(const dvrk_topics_rate::rate rate,
+                                 const double & period_in_seconds)
+{
+    mRates[rate].Period = period_in_seconds;
+    mRates[rate].Next = 0.0;
+}
+
+double dvrk::bridge::RatePeriod(const dvrk_topics_rate::rate rate) const
+{
+    return mRates[rate].Period;
+}
+
+size_t dvrk::bridge::SetTopicRate(const std::string & topic_name,
+                                  const dvrk_topics_rate::rate rate)
+{
+    size_t found = 0;
+    const PublishersType::iterator end = mPublishers.end();
+    PublishersType::iterator iter;
+    for (iter = mPublishers.begin();
+         iter != end;
+         ++iter) {
+        if (TopicMatches((*iter)->TopicName(), topic_name)) {
+            (*iter)->SetRate(rate);
+            ++found;
+        }
+    }
+    return found;
+}
+
+size_t dvrk::bridge::SetTopicOnChange(const std::string & topic_name,
+                                      const double & deadband)
+{
+    size_t found = 0;
+    const PublishersType::iterator end = mPublishers.end();
+    PublishersType::iterator iter;
+    for (iter = mPublishers.begin();
+         iter != end;
+         ++iter) {
+        if (TopicMatches((*iter)->TopicName(), topic_name)) {
+            (*iter)->SetOnChange(true, deadband);
+            ++found;
+        }
+    }
+    return found;
+}
+
+size_t dvrk::bridge::RemoveTopics(const std::string & topic_name)
+{
+    size_t found = 0;
+    PublishersType::iterator iter = mPublishers.begin();
+    while (iter != mPublishers.end()) {
+        if (TopicMatches((*iter)->TopicName(), topic_name)) {
+            if (*iter == mTfPublisher) {
+                mTfPublisher = 0;
+            }
+            mDeferredPublishers.remove(*iter);
+            delete *iter;
+            iter = mPublishers.erase(iter);
+            ++found;
+        } else {
+            ++iter;
+        }
+    }
+    return found;
+}
+
+void dvrk::bridge::SetLazy(const bool lazy)
+{
+    mLazy = lazy;
+    const PublishersType::iterator end = mPublishers.end();
+    PublishersType::iterator iter;
+    for (iter = mPublishers.begin();
+         iter != end;
+         ++iter) {
+        (*iter)->SetLazy(lazy);
+    }
+}
+
+void dvrk::bridge::SetThreadSettings(const thread_settings & settings)
+{
+    mThreadSettings = settings;
+}
+
+bool dvrk::bridge::SetTrigger(const std::string & interface_required_name,
+                              const size_t decimation)
+{
+    mtsInterfaceRequired * interfaceRequired = this->AddInterfaceRequired(interface_required_name);
+    if (!interfaceRequired) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetTrigger: failed to create required interface \""
+                                 << interface_required_name << "\"" << std::endl;
+        return false;
+    }
+    interfaceRequired->AddEventHandlerVoid(&bridge::TriggerEventHandler, this,
+                                           "RunEvent", MTS_EVENT_NOT_QUEUED);
+    mTrigger.Enabled = true;
+    // fast topics are published on every trigger, use decimation to
+    // reduce the rate
+    mRates[dvrk_topics_rate::fast].Period = 0.0;
+    mTrigger.Decimation = std::max(decimation, static_cast<size_t>(1));
+    mTrigger.Counter = 0;
+    return true;
+}
+
+void dvrk::bridge::TriggerEventHandler(void)
+{
+    ++mTrigger.Counter;
+    if (mTrigger.Counter >= mTrigger.Decimation) {
+        mTrigger.Counter = 0;
+        mTrigger.Signal.Raise();
+    }
+}
+
+dvrk::latest_command_group * dvrk::bridge::LatestCommandGroup(const std::string & interface_required_name)
+{
+    const LatestCommandGroupsType::iterator found = mLatestCommandGroups.find(interface_required_name);
+    if (found != mLatestCommandGroups.end()) {
+        return found->second;
+    }
+    mtsInterfaceRequired * interfaceRequired = this->AddInterfaceRequired(interface_required_name);
+    mtsInterfaceRequired * runInterfaceRequired = this->AddInterfaceRequired(interface_required_name + "-run");
+    if (!interfaceRequired || !runInterfaceRequired) {
+        CMN_LOG_CLASS_INIT_ERROR << "LatestCommandGroup: failed to create required interfaces for \""
+                                 << interface_required_name << "\"" << std::endl;
+        return 0;
+    }
+    latest_command_group * group = new latest_command_group;
+    runInterfaceRequired->AddEventHandlerVoid(&latest_command_group::RunEventHandler, group,
+                                              "RunEvent", MTS_EVENT_NOT_QUEUED);
+    mLatestCommandGroups[interface_required_name] = group;
+    return group;
+}
+
+mtsFunctionWrite * dvrk::bridge::FunctionWrite(const std::string & interface_required_name,
+                                               const std::string & function_name)
+{
+    const std::string key = interface_required_name + "::" + function_name;
+    const FunctionsWriteType::iterator found = mFunctionsWrite.find(key);
+    if (found != mFunctionsWrite.end()) {
+        return found->second;
+    }
+    // check if the interface exists or try to create one
+    mtsInterfaceRequired * interfaceRequired = this->GetInterfaceRequired(interface_required_name);
+    if (!interfaceRequired) {
+        interfaceRequired = this->AddInterfaceRequired(interface_required_name);
+    }
+    if (!interfaceRequired) {
+        CMN_LOG_CLASS_INIT_ERROR << "FunctionWrite: failed to create required interface \""
+                                 << interface_required_name << "\"" << std::endl;
+        return 0;
+    }
+    mtsFunctionWrite * function = new mtsFunctionWrite;
+    if (!interfaceRequired->AddFunction(function_name, *function)) {
+        delete function;
+        return 0;
+    }
+    mFunctionsWrite[key] = function;
+    return function;
+}
+
+bool dvrk::bridge::TopicMatches(const std::string & topic_name,
+                                const std::string & pattern)
+{
+    if (topic_name == pattern) {
+        return true;
+    }
+    // suffix starting after a "/", fnmatch's * also matches "/"
+    const std::string suffixPattern = "*/" + pattern;
+    return (fnmatch(suffixPattern.c_str(), topic_name.c_str(), 0) == 0);
+}
@@ -0,0 +1,499 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-21
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// Benchmark for the dVRK ROS bridges without hardware.  Synthetic
+// arms provide the same commands and events as a dVRK PSM ("Robot"
+// interface) and the bridges are populated using the same functions
+// as dvrk::console.  The benchmark reports the bridges' cycle time,
+// the process CPU usage and the rate at which subscribers receive
+// messages.  Only requires a roscore.
+
+// system
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <list>
+#include <sstream>
+#include <atomic>
+#include <sys/resource.h>
+
+// cisst/saw
+#include <cisstCommon/cmnCommandLineOptions.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstMultiTask/mtsTaskPeriodic.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <cisstParameterTypes/prmStateJoint.h>
+#include <cisstParameterTypes/prmPositionJointGet.h>
+#include <cisstParameterTypes/prmPositionCartesianGet.h>
+#include <cisstParameterTypes/prmVelocityCartesianGet.h>
+#include <cisstParameterTypes/prmForceCartesianGet.h>
+
+#include <ros/ros.h>
+#include <sensor_msgs/JointState.h>
+#include <dvrk_robot/ArmState.h>
+#include <dvrk_utilities/dvrk_add_topics_functions.h>
+
+namespace dvrk {
+
+    /*! Arm without hardware nor kinematics, provides the same
+      commands and events as a dVRK PSM on the "Robot" interface.
+      The state is updated on every period so the bridges get new
+      samples at the arm's rate. */
+    class synthetic_arm: public mtsTaskPeriodic
+    {
+    public:
+        synthetic_arm(const std::string & name,
+                      const double & period_in_seconds,
+                      const size_t number_of_joints = 6):
+            mtsTaskPeriodic(name, period_in_seconds, false, 500),
+            mCommandsReceived(0)
+        {
+            mStateJoint.Position().SetSize(number_of_joints);
+            mStateJoint.Velocity().SetSize(number_of_joints);
+            mStateJoint.Effort().SetSize(number_of_joints);
+            mStateJointDesired = mStateJoint;
+            mPositionJoint.Position().SetSize(number_of_joints);
+            mPositionJointDesired.SetSize(number_of_joints);
+            mStateJaw.Position().SetSize(1);
+            mStateJaw.Velocity().SetSize(1);
+            mStateJaw.Effort().SetSize(1);
+            mStateJawDesired = mStateJaw;
+            mJacobianBody.SetSize(6, number_of_joints);
+            mJacobianSpatial.SetSize(6, number_of_joints);
+
+            StateTable.AddData(mStateJoint, "StateJoint");
+            StateTable.AddData(mStateJointDesired, "StateJointDesired");
+            StateTable.AddData(mPositionJoint, "PositionJoint");
+            StateTable.AddData(mPositionJointDesired, "PositionJointDesired");
+            StateTable.AddData(mPositionCartesian, "PositionCartesian");
+            StateTable.AddData(mPositionCartesianDesired, "PositionCartesianDesired");
+            StateTable.AddData(mPositionCartesianLocal, "PositionCartesianLocal");
+            StateTable.AddData(mPositionCartesianLocalDesired, "PositionCartesianLocalDesired");
+            StateTable.AddData(mVelocityCartesian, "VelocityCartesian");
+            StateTable.AddData(mWrenchBody, "WrenchBody");
+            StateTable.AddData(mJacobianBody, "JacobianBody");
+            StateTable.AddData(mJacobianSpatial, "JacobianSpatial");
+            StateTable.AddData(mStateJaw, "StateJaw");
+            StateTable.AddData(mStateJawDesired, "StateJawDesired");
+
+            mtsInterfaceProvided * interfaceProvided = AddInterfaceProvided("Robot");
+            if (!interfaceProvided) {
+                return;
+            }
+            // read
+            interfaceProvided->AddCommandReadState(StateTable, mStateJoint, "GetStateJoint");
+            interfaceProvided->AddCommandReadState(StateTable, mStateJointDesired, "GetStateJointDesired");
+            interfaceProvided->AddCommandReadState(StateTable, mPositionJoint, "GetPositionJoint");
+            interfaceProvided->AddCommandReadState(StateTable, mPositionJointDesired, "GetPositionJointDesired");
+            interfaceProvided->AddCommandReadState(StateTable, mPositionCartesian, "GetPositionCartesian");
+            interfaceProvided->AddCommandReadState(StateTable, mPositionCartesianDesired, "GetPositionCartesianDesired");
+            interfaceProvided->AddCommandReadState(StateTable, mPositionCartesianLocal, "GetPositionCartesianLocal");
+            interfaceProvided->AddCommandReadState(StateTable, mPositionCartesianLocalDesired, "GetPositionCartesianLocalDesired");
+            interfaceProvided->AddCommandReadState(StateTable, mVelocityCartesian, "GetVelocityCartesian");
+            interfaceProvided->AddCommandReadState(StateTable, mWrenchBody, "GetWrenchBody");
+            interfaceProvided->AddCommandReadState(StateTable, mJacobianBody, "GetJacobianBody");
+            interfaceProvided->AddCommandReadState(StateTable, mJacobianSpatial, "GetJacobianSpatial");
+            interfaceProvided->AddCommandReadState(StateTable, mStateJaw, "GetStateJaw");
+            interfaceProvided->AddCommandReadState(StateTable, mStateJawDesired, "GetStateJawDesired");
+            // write, commands are only counted
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<prmPositionCartesianSet>, this, "SetBaseFrame");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<std::string>, this, "SetDesiredState");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<double>, this, "SetJointVelocityRatio");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<double>, this, "SetJointAccelerationRatio");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<prmPositionJointSet>, this, "SetPositionJoint");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<prmPositionJointSet>, this, "SetPositionGoalJoint");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<prmPositionCartesianSet>, this, "SetPositionCartesian");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<prmPositionCartesianSet>, this, "SetPositionGoalCartesian");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<prmForceTorqueJointSet>, this, "SetEffortJoint");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<prmForceCartesianSet>, this, "SetWrenchBody");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<prmForceCartesianSet>, this, "SetWrenchSpatial");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<bool>, this, "SetWrenchBodyOrientationAbsolute");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<bool>, this, "SetGravityCompensation");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<prmCartesianImpedanceGains>, this, "SetCartesianImpedanceGains");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<prmPositionJointSet>, this, "SetPositionJaw");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<prmPositionJointSet>, this, "SetPositionGoalJaw");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<prmForceTorqueJointSet>, this, "SetEffortJaw");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<bool>, this, "SetAdapterPresent");
+            interfaceProvided->AddCommandWrite(&synthetic_arm::CommandReceived<bool>, this, "SetToolPresent");
+            // events
+            interfaceProvided->AddEventWrite(Events.Error, "Error", mtsMessage());
+            interfaceProvided->AddEventWrite(Events.Warning, "Warning", mtsMessage());
+            interfaceProvided->AddEventWrite(Events.Status, "Status", mtsMessage());
+            interfaceProvided->AddEventWrite(Events.CurrentState, "CurrentState", std::string());
+            interfaceProvided->AddEventWrite(Events.DesiredState, "DesiredState", std::string());
+            interfaceProvided->AddEventWrite(Events.GoalReached, "GoalReached", false);
+            interfaceProvided->AddEventWrite(Events.JointVelocityRatio, "JointVelocityRatio", 1.0);
+            interfaceProvided->AddEventWrite(Events.JointAccelerationRatio, "JointAccelerationRatio", 1.0);
+            interfaceProvided->AddEventWrite(Events.ManipClutch, "ManipClutch", prmEventButton());
+        }
+
+        void Startup(void) {
+            mNextEvent = 0.0;
+        }
+
+        void Run(void) {
+            ProcessQueuedCommands();
+            const double time = StateTable.GetTic();
+            // joint space
+            for (size_t index = 0; index < mStateJoint.Position().size(); ++index) {
+                const double phase = time + static_cast<double>(index);
+                mStateJoint.Position()[index] = std::sin(phase);
+                mStateJoint.Velocity()[index] = std::cos(phase);
+                mStateJoint.Effort()[index] = 0.1 * std::sin(phase);
+                mStateJointDesired.Position()[index] = mStateJoint.Position()[index];
+                mPositionJoint.Position()[index] = mStateJoint.Position()[index];
+                mPositionJointDesired[index] = mStateJoint.Position()[index];
+            }
+            mStateJaw.Position()[0] = std::sin(time);
+            mStateJawDesired.Position()[0] = mStateJaw.Position()[0];
+            // cartesian space
+            mPositionCartesian.Position().Translation()[0] = 0.01 * std::sin(time);
+            mPositionCartesian.Position().Translation()[1] = 0.01 * std::cos(time);
+            mPositionCartesian.Position().Translation()[2] = -0.1;
+            mPositionCartesianDesired.Position() = mPositionCartesian.Position();
+            mPositionCartesianLocal.Position() = mPositionCartesian.Position();
+            mPositionCartesianLocalDesired.Position() = mPositionCartesian.Position();
+            mVelocityCartesian.VelocityLinear()[0] = 0.01 * std::cos(time);
+            mWrenchBody.F()[2] = std::sin(time);
+            SetValid(time);
+            // low rate events
+            if (time >= mNextEvent) {
+                Events.CurrentState(std::string("READY"));
+                mNextEvent = time + 1.0;
+            }
+        }
+
+        inline size_t CommandsReceived(void) const {
+            return mCommandsReceived;
+        }
+
+    protected:
+        template <typename _type>
+        void CommandReceived(const _type & CMN_UNUSED(command)) {
+            ++mCommandsReceived;
+        }
+
+        void SetValid(const double & time) {
+            mtsGenericObject * samples[] = {&mStateJoint, &mStateJointDesired, &mPositionJoint,
+                                            &mPositionCartesian, &mPositionCartesianDesired,
+                                            &mPositionCartesianLocal, &mPositionCartesianLocalDesired,
+                                            &mVelocityCartesian, &mWrenchBody,
+                                            &mStateJaw, &mStateJawDesired};
+            for (size_t index = 0; index < sizeof(samples) / sizeof(samples[0]); ++index) {
+                samples[index]->SetTimestamp(time);
+                samples[index]->SetValid(true);
+            }
+        }
+
+        prmStateJoint mStateJoint, mStateJointDesired, mStateJaw, mStateJawDesired;
+        prmPositionJointGet mPositionJoint;
+        vctDoubleVec mPositionJointDesired;
+        prmPositionCartesianGet mPositionCartesian, mPositionCartesianDesired,
+            mPositionCartesianLocal, mPositionCartesianLocalDesired;
+        prmVelocityCartesianGet mVelocityCartesian;
+        prmForceCartesianGet mWrenchBody;
+        vctDoubleMat mJacobianBody, mJacobianSpatial;
+
+        struct {
+            mtsFunctionWrite Error, Warning, Status;
+            mtsFunctionWrite CurrentState, DesiredState;
+            mtsFunctionWrite GoalReached;
+            mtsFunctionWrite JointVelocityRatio, JointAccelerationRatio;
+            mtsFunctionWrite ManipClutch;
+        } Events;
+
+        double mNextEvent;
+        size_t mCommandsReceived;
+    };
+
+    /*! Publish bridge measuring the time spent in each cycle. */
+    class benchmark_bridge: public dvrk::bridge
+    {
+    public:
+        benchmark_bridge(const std::string & component_name,
+                         const double & period_in_seconds):
+            dvrk::bridge(component_name, period_in_seconds, false, false),
+            mCycles(0),
+            mTotal(0.0),
+            mMaximum(0.0)
+        {}
+
+        void Run(void) {
+            const double start = osaGetTime();
+            dvrk::bridge::Run();
+            const double elapsed = osaGetTime() - start;
+            ++mCycles;
+            mTotal += elapsed;
+            if (elapsed > mMaximum) {
+                mMaximum = elapsed;
+            }
+        }
+
+        inline size_t Cycles(void) const {
+            return mCycles;
+        }
+
+        inline double Average(void) const {
+            return (mCycles == 0) ? 0.0 : (mTotal / static_cast<double>(mCycles));
+        }
+
+        inline double Maximum(void) const {
+            return mMaximum;
+        }
+
+    protected:
+        size_t mCycles;
+        double mTotal;
+        double mMaximum;
+    };
+
+    /*! Count the messages received on a topic. */
+    template <typename _rosType>
+    class benchmark_subscriber
+    {
+    public:
+        benchmark_subscriber(ros::NodeHandle & node_handle,
+                             const std::string & topic_name):
+            mTopicName(topic_name),
+            mCount(0)
+        {
+            mSubscriber = node_handle.subscribe(topic_name, 10,
+                                                &benchmark_subscriber::Callback, this);
+        }
+
+        void Callback(const typename _rosType::ConstPtr & CMN_UNUSED(message)) {
+            ++mCount;
+        }
+
+        inline const std::string & TopicName(void) const {
+            return mTopicName;
+        }
+
+        inline size_t Count(void) const {
+            return mCount.load();
+        }
+
+    protected:
+        std::string mTopicName;
+        std::atomic<size_t> mCount;
+        ros::Subscriber mSubscriber;
+    };
+}
+
+template <typename _subscribers>
+size_t total_count(const _subscribers & subscribers)
+{
+    size_t count = 0;
+    typename _subscribers::const_iterator subscriber;
+    for (subscriber = subscribers.begin();
+         subscriber != subscribers.end();
+         ++subscriber) {
+        count += (*subscriber)->Count();
+    }
+    return count;
+}
+
+double cpu_time(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+        + 1.0e-6 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+int main(int argc, char ** argv)
+{
+    // log configuration
+    cmnLogger::SetMask(CMN_LOG_ALLOW_ALL);
+    cmnLogger::SetMaskFunction(CMN_LOG_ALLOW_ALL);
+    cmnLogger::SetMaskDefaultLog(CMN_LOG_ALLOW_ALL);
+    cmnLogger::AddChannel(std::cerr, CMN_LOG_ALLOW_ERRORS_AND_WARNINGS);
+
+    ros::init(argc, argv, "dvrk_bridge_benchmark",
+              ros::init_options::NoSigintHandler | ros::init_options::AnonymousName);
+
+    // parse options
+    cmnCommandLineOptions options;
+    int numberOfArms = 4;
+    int numberOfSubscribers = 1;
+    double armPeriod = 1.0 * cmn_ms;
+    double rosPeriod = 10.0 * cmn_ms;
+    double duration = 10.0;
+    std::string rosNamespace = "benchmark/";
+    std::list<std::string> versionStrings;
+
+    options.AddOptionOneValue("a", "arms",
+                              "number of synthetic arms (default 4)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &numberOfArms);
+    options.AddOptionOneValue("s", "subscribers",
+                              "number of subscribers per arm for the joint state and arm state topics (default 1)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &numberOfSubscribers);
+    options.AddOptionOneValue("r", "arm-period",
+                              "period in seconds of the synthetic arms (default 0.001)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &armPeriod);
+    options.AddOptionOneValue("p", "ros-period",
+                              "period in seconds of the publish bridges (default 0.01)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &rosPeriod);
+    options.AddOptionOneValue("d", "duration",
+                              "duration of the measurement in seconds (default 10)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &duration);
+    options.AddOptionOneValue("n", "ros-namespace",
+                              "ROS namespace to prefix all topics (default \"benchmark/\")",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &rosNamespace);
+    options.AddOptionMultipleValues("c", "compatibility",
+                                    "compatibility mode(s), e.g. \"v1_4_0\" (default), \"crtk_alpha\"",
+                                    cmnCommandLineOptions::OPTIONAL_OPTION, &versionStrings);
+    options.AddOptionNoValue("b", "bridge-per-arm",
+                             "use a separate bridge (i.e. thread) to publish each arm's topics");
+    options.AddOptionNoValue("L", "not-lazy",
+                             "publish all topics, even without subscribers");
+    options.AddOptionNoValue("S", "subscribers-only",
+                             "only create the subscribers, use with a benchmark running in another process to include serialization and transport");
+
+    std::string errorMessage;
+    if (!options.Parse(argc, argv, errorMessage)) {
+        std::cerr << "Error: " << errorMessage << std::endl;
+        options.PrintUsage(std::cerr);
+        return -1;
+    }
+
+    if (versionStrings.empty()) {
+        versionStrings.push_back("v1_4_0");
+    }
+    dvrk::topics_versions versions;
+    const std::list<std::string>::const_iterator versionsEnd = versionStrings.end();
+    std::list<std::string>::const_iterator versionString;
+    for (versionString = versionStrings.begin();
+         versionString != versionsEnd;
+         ++versionString) {
+        try {
+            versions.push_back(dvrk_topics_version::versionFromString(*versionString));
+        } catch (std::exception &) {
+            std::cerr << "Compatibility mode " << *versionString << " is invalid" << std::endl;
+            return -1;
+        }
+    }
+    const std::string jointTopic =
+        (versions.front() == dvrk_topics_version::crtk_alpha) ? "/measured_js" : "/state_joint_current";
+
+    const bool subscribersOnly = options.IsSet("subscribers-only");
+    const bool bridgePerArm = options.IsSet("bridge-per-arm");
+
+    // subscribers
+    ros::NodeHandle nodeHandle;
+    typedef dvrk::benchmark_subscriber<sensor_msgs::JointState> JointSubscriber;
+    typedef dvrk::benchmark_subscriber<dvrk_robot::ArmState> StateSubscriber;
+    std::list<JointSubscriber *> jointSubscribers;
+    std::list<StateSubscriber *> stateSubscribers;
+    for (int arm = 0; arm < numberOfArms; ++arm) {
+        std::stringstream armNameSpace;
+        armNameSpace << rosNamespace << "PSM" << arm;
+        for (int subscriber = 0; subscriber < numberOfSubscribers; ++subscriber) {
+            jointSubscribers.push_back(new JointSubscriber(nodeHandle, armNameSpace.str() + jointTopic));
+            stateSubscribers.push_back(new StateSubscriber(nodeHandle, armNameSpace.str() + "/state"));
+        }
+    }
+    ros::AsyncSpinner spinner(1);
+    spinner.start();
+
+    // synthetic arms and bridges, populated like dvrk::console does
+    mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+    std::list<dvrk::benchmark_bridge *> bridges;
+    if (!subscribersOnly) {
+        dvrk::benchmark_bridge * bridge = 0;
+        for (int arm = 0; arm < numberOfArms; ++arm) {
+            std::stringstream armName;
+            armName << "PSM" << arm;
+            if (!bridge || bridgePerArm) {
+                bridge = new dvrk::benchmark_bridge("benchmark_bridge_" + armName.str(), rosPeriod);
+                bridge->SetRatePeriod(dvrk_topics_rate::medium, std::max(rosPeriod, 20.0 * cmn_ms));
+                bridge->SetRatePeriod(dvrk_topics_rate::slow, std::max(rosPeriod, 100.0 * cmn_ms));
+                bridge->SetLazy(!options.IsSet("not-lazy"));
+                componentManager->AddComponent(bridge);
+                bridges.push_back(bridge);
+            }
+            dvrk::synthetic_arm * syntheticArm = new dvrk::synthetic_arm(armName.str(), armPeriod);
+            componentManager->AddComponent(syntheticArm);
+            dvrk::add_topics_psm(*bridge, rosNamespace + armName.str(), armName.str(), versions);
+            dvrk::connect_bridge_psm(bridge->GetName(), armName.str(),
+                                     syntheticArm->GetName(), "Robot");
+        }
+        componentManager->CreateAllAndWait(5.0 * cmn_s);
+        componentManager->StartAllAndWait(5.0 * cmn_s);
+    }
+
+    std::cout << "Measuring for " << duration << " seconds with "
+              << numberOfArms << " arm(s), " << numberOfSubscribers << " subscriber(s) per topic and "
+              << bridges.size() << " bridge(s)" << std::endl;
+    // let subscribers connect before measuring
+    osaSleep(1.0 * cmn_s);
+    const size_t jointStart = total_count(jointSubscribers);
+    const size_t stateStart = total_count(stateSubscribers);
+    const double cpuStart = cpu_time();
+    const double timeStart = osaGetTime();
+    osaSleep(duration);
+    const double elapsed = osaGetTime() - timeStart;
+    const double cpuUsage = (cpu_time() - cpuStart) / elapsed;
+    const size_t jointMessages = total_count(jointSubscribers) - jointStart;
+    const size_t stateMessages = total_count(stateSubscribers) - stateStart;
+
+    if (!subscribersOnly) {
+        componentManager->KillAllAndWait(5.0 * cmn_s);
+        componentManager->Cleanup();
+    }
+    spinner.stop();
+
+    // report
+    std::cout << std::fixed << std::setprecision(3)
+              << "CPU usage: " << 100.0 * cpuUsage << "% of one core" << std::endl;
+    std::list<dvrk::benchmark_bridge *>::const_iterator bridge;
+    for (bridge = bridges.begin();
+         bridge != bridges.end();
+         ++bridge) {
+        std::cout << (*bridge)->GetName() << ": " << (*bridge)->Cycles() << " cycles, average "
+                  << (*bridge)->Average() / cmn_ms << " ms, max "
+                  << (*bridge)->Maximum() / cmn_ms << " ms" << std::endl;
+    }
+    if (!jointSubscribers.empty()) {
+        const double scale = 1.0 / (elapsed * static_cast<double>(jointSubscribers.size()));
+        std::cout << "Joint state topic (" << jointTopic.substr(1) << "): "
+                  << scale * jointMessages << " Hz per subscriber" << std::endl
+                  << "Arm state topic (state): "
+                  << scale * stateMessages << " Hz per subscriber" << std::endl
+                  << "Expected: " << 1.0 / rosPeriod << " Hz" << std::endl;
+    }
+
+    const std::list<JointSubscriber *>::const_iterator jointEnd = jointSubscribers.end();
+    std::list<JointSubscriber *>::const_iterator jointSubscriber;
+    for (jointSubscriber = jointSubscribers.begin();
+         jointSubscriber != jointEnd;
+         ++jointSubscriber) {
+        delete *jointSubscriber;
+    }
+    const std::list<StateSubscriber *>::const_iterator stateEnd = stateSubscribers.end();
+    std::list<StateSubscriber *>::const_iterator stateSubscriber;
+    for (stateSubscriber = stateSubscribers.begin();
+         stateSubscriber != stateEnd;
+         ++stateSubscriber) {
+        delete *stateSubscriber;
+    }
+
+    ros::shutdown();
+    return 0;
+}
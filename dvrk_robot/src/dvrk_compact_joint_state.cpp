@@ -0,0 +1,120 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-30
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstMultiTask/mtsManagerLocal.h>
+
+#include <dvrk_utilities/dvrk_compact_joint_state.h>
+
+namespace {
+
+    // both messages have the same fields, only the scalar type differs
+    template <typename _rosType>
+    bool compact_joint_state_from_cisst(const prmStateJoint & cisstData,
+                                        _rosType & rosData,
+                                        const std::string & debugInfo)
+    {
+        const size_t size = cisstData.Position().size();
+        if (size > _rosType::MAXIMUM_JOINTS) {
+            CMN_LOG_RUN_ERROR << "mtsCISSTToROS: " << debugInfo << ", " << size
+                              << " joints, compact joint states are limited to "
+                              << static_cast<size_t>(_rosType::MAXIMUM_JOINTS) << std::endl;
+            return false;
+        }
+        // same as cisst_ros_bridge, stamp is the cisst timestamp
+        // converted to ROS time
+        if (cisstData.Timestamp() > 0.0) {
+            const double age =
+                mtsManagerLocal::GetInstance()->GetTimeServer().GetRelativeTime() - cisstData.Timestamp();
+            rosData.stamp = ros::Time::now() - ros::Duration(age);
+        } else {
+            rosData.stamp = ros::Time::now();
+        }
+        rosData.number_of_joints = size;
+        rosData.fields = 0;
+        rosData.position.assign(0);
+        rosData.velocity.assign(0);
+        rosData.effort.assign(0);
+        if (size == 0) {
+            return true;
+        }
+        std::copy(cisstData.Position().begin(), cisstData.Position().end(),
+                  rosData.position.begin());
+        rosData.fields |= _rosType::POSITION;
+        if (cisstData.Velocity().size() == size) {
+            std::copy(cisstData.Velocity().begin(), cisstData.Velocity().end(),
+                      rosData.velocity.begin());
+            rosData.fields |= _rosType::VELOCITY;
+        }
+        if (cisstData.Effort().size() == size) {
+            std::copy(cisstData.Effort().begin(), cisstData.Effort().end(),
+                      rosData.effort.begin());
+            rosData.fields |= _rosType::EFFORT;
+        }
+        return true;
+    }
+}
+
+bool mtsCISSTToROS(const prmStateJoint & cisstData,
+                   dvrk_robot::CompactJointState & rosData,
+                   const std::string & debugInfo)
+{
+    return compact_joint_state_from_cisst(cisstData, rosData, debugInfo);
+}
+
+bool mtsCISSTToROS(const prmStateJoint & cisstData,
+                   dvrk_robot::CompactJointState32 & rosData,
+                   const std::string & debugInfo)
+{
+    return compact_joint_state_from_cisst(cisstData, rosData, debugInfo);
+}
+
+dvrk::joint_state_description_publisher::joint_state_description_publisher(command_read_source<prmStateJoint> * source,
+                                                                           const std::string & topic_name,
+                                                                           const dvrk_topics_rate::rate rate):
+    publisher_base(topic_name, rate),
+    mSource(source),
+    mFirst(true)
+{
+}
+
+void dvrk::joint_state_description_publisher::Advertise(ros::NodeHandle & node_handle)
+{
+    // latched, clients get the description when they subscribe
+    mPublisher = node_handle.advertise<dvrk_robot::JointStateDescription>(mTopicName, mQueueSize, true);
+}
+
+bool dvrk::joint_state_description_publisher::Execute(void)
+{
+    // not lazy since the topic is latched
+    if (!mSource->Read()) {
+        return false;
+    }
+    const prmStateJoint & cisstData = mSource->Data();
+    if (!dvrk::sample_valid(cisstData)) {
+        return true;
+    }
+    if (!mFirst && (cisstData.Name() == mNames)) {
+        return true;
+    }
+    mNames = cisstData.Name();
+    mFirst = false;
+    dvrk_robot::JointStateDescription::Ptr rosData(new dvrk_robot::JointStateDescription);
+    rosData->name = mNames;
+    mPublisher.publish(rosData);
+    return true;
+}
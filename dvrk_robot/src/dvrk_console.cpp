@@ -16,25 +16,131 @@ http://www.cisst.org/cisst/license.txt.
 --- end cisst license ---
 */
 
+#include <algorithm>
+
 #include <dvrk_utilities/dvrk_console.h>
+#include <dvrk_utilities/dvrk_state_recorder.h>
+#include <dvrk_utilities/dvrk_shared_state_writer.h>
+#include <dvrk_utilities/dvrk_timing_monitor.h>
+#include <dvrk_utilities/dvrk_thread_configurator.h>
 #include <cisst_ros_bridge/mtsROSBridge.h>
 
 #include <cisstCommon/cmnStrings.h>
+#include <cisstMultiTask/mtsTask.h>
 #include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitConsole.h>
 
 #include <json/json.h>
 
 const std::string bridgeNamePrefix = "dVRKIOBridge";
 
+// default periods for the slower rate classes, see dvrk_topics_rate
+const double mediumRatePeriod = 20.0 * cmn_ms;
+const double slowRatePeriod = 100.0 * cmn_ms;
+// the spin bridge blocks on the ROS callback queue, the period is only
+// used for queued commands/events and statistics
+const double spinBridgePeriod = 10.0 * cmn_ms;
+
+namespace {
+    // create a bridge used to publish an arm's topics, or all
+    // topics if the console doesn't use one bridge per arm
+    dvrk::bridge * create_publish_bridge(const std::string & name,
+                                         const double & publish_rate_in_seconds,
+                                         const bool defer_advertisement)
+    {
+        dvrk::bridge * pub_bridge = new dvrk::bridge(name, publish_rate_in_seconds, false, false); // don't spin, don't catch sigint
+        pub_bridge->SetDeferAdvertisement(defer_advertisement);
+        pub_bridge->AddIntervalStatisticsInterface();
+        pub_bridge->SetRatePeriod(dvrk_topics_rate::medium,
+                                  std::max(publish_rate_in_seconds, mediumRatePeriod));
+        pub_bridge->SetRatePeriod(dvrk_topics_rate::slow,
+                                  std::max(publish_rate_in_seconds, slowRatePeriod));
+        return pub_bridge;
+    }
+
+    // arm names from a JSON list, all arms but SUJs if the list is
+    // empty.  Returns false if an arm doesn't exist.
+    bool arm_names_from_json(const Json::Value & arms,
+                             const mtsIntuitiveResearchKitConsole * console,
+                             const std::string & field,
+                             std::list<std::string> & arm_names)
+    {
+        if (arms.empty()) {
+            const mtsIntuitiveResearchKitConsole::ArmList::const_iterator armEnd = console->mArms.end();
+            mtsIntuitiveResearchKitConsole::ArmList::const_iterator armIter;
+            for (armIter = console->mArms.begin();
+                 armIter != armEnd;
+                 ++armIter) {
+                if (armIter->second->mType != mtsIntuitiveResearchKitConsole::Arm::ARM_SUJ) {
+                    arm_names.push_back(armIter->first);
+                }
+            }
+            return true;
+        }
+        for (unsigned int index = 0; index < arms.size(); ++index) {
+            const std::string name = arms[index].asString();
+            if (console->mArms.find(name) == console->mArms.end()) {
+                std::cerr << "Configure: no arm named \"" << name << "\" in \"" << field << "\"" << std::endl;
+                return false;
+            }
+            arm_names.push_back(name);
+        }
+        return true;
+    }
+
+    // monitor a periodic task's timing, returns false if the
+    // component doesn't exist or is not periodic
+    bool add_timing_task(dvrk::timing_monitor * monitor,
+                         const std::string & component_name)
+    {
+        mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+        const mtsTask * task =
+            dynamic_cast<const mtsTask *>(componentManager->GetComponent(component_name));
+        if (!task || (task->GetPeriodicity() <= 0.0)) {
+            return false;
+        }
+        return monitor->AddTask(component_name, task->GetPeriodicity())
+            && componentManager->Connect(monitor->GetName(), component_name + "-run",
+                                         component_name, "ExecOut");
+    }
+
+    // apply (or only report) thread settings for a task, returns
+    // false if the component doesn't exist or is not a task
+    bool add_thread_task(dvrk::thread_configurator * configurator,
+                         const std::string & component_name,
+                         const dvrk::thread_settings & settings,
+                         const bool apply)
+    {
+        mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+        if (!dynamic_cast<const mtsTask *>(componentManager->GetComponent(component_name))) {
+            return false;
+        }
+        return configurator->AddTask(component_name, settings, apply)
+            && componentManager->Connect(configurator->GetName(), component_name + "-run",
+                                         component_name, "ExecOut");
+    }
+}
+
 dvrk::console::console(const double & publish_rate_in_seconds,
                        const double & tf_rate_in_seconds,
                        const std::string & ros_namespace,
                        mtsIntuitiveResearchKitConsole * mts_console,
-                       const dvrk_topics_version::version version):
+                       const dvrk::topics_versions & versions,
+                       const bool bridge_per_arm,
+                       const bool defer_advertisement):
     mNameSpace(ros_namespace),
     mConsole(mts_console),
-    mVersion(version)
+    mVersions(versions),
+    mDeferAdvertisement(defer_advertisement),
+    mSharedState(0),
+    mTimingMonitor(0),
+    mThreadConfigurator(0)
 {
+    // thread settings per component class, see SetThreadSettings
+    mThreadSettings["io"] = dvrk::thread_settings();
+    mThreadSettings["arms"] = dvrk::thread_settings();
+    mThreadSettings["teleop"] = dvrk::thread_settings();
+    mThreadSettings["bridges"] = dvrk::thread_settings();
+
     // start creating components
     mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
 
@@ -45,17 +151,17 @@ dvrk::console::console(const double & publish_rate_in_seconds,
     std::replace(bridgeName.begin(), bridgeName.end(), '-', '_');
     std::replace(bridgeName.begin(), bridgeName.end(), '.', '_');
 
-    // publish bridge
-    mtsROSBridge * pub_bridge = new mtsROSBridge(bridgeName, publish_rate_in_seconds, false, false); // don't spin, don't catch sigint
-    pub_bridge->AddIntervalStatisticsInterface();
+    // publish bridge, the bridge period is used for the fast rate class
+    mProfiler.Begin("create bridges");
+    dvrk::bridge * pub_bridge = create_publish_bridge(bridgeName, publish_rate_in_seconds, defer_advertisement);
     // bridge for tf
-    mtsROSBridge * tf_bridge = new mtsROSBridge(bridgeName + "_tf2", tf_rate_in_seconds, false, false);
+    dvrk::bridge * tf_bridge = new dvrk::bridge(bridgeName + "_tf2", tf_rate_in_seconds, false, false);
     tf_bridge->AddIntervalStatisticsInterface();
     // separate thread to spin, i.e. subscribe
-    mtsROSBridge * spin_bridge = new mtsROSBridge(bridgeName + "_spin", 0.1 * cmn_ms, true, false);
+    dvrk::bridge * spin_bridge = new dvrk::bridge(bridgeName + "_spin", spinBridgePeriod, true, false);
     spin_bridge->AddIntervalStatisticsInterface();
     // bridge to publish stats
-    mtsROSBridge * stats_bridge = new mtsROSBridge(bridgeName + "_stats", 200.0 * cmn_ms, false, false);
+    dvrk::bridge * stats_bridge = new dvrk::bridge(bridgeName + "_stats", 200.0 * cmn_ms, false, false);
 
     componentManager->AddComponent(pub_bridge);
     componentManager->AddComponent(tf_bridge);
@@ -63,14 +169,30 @@ dvrk::console::console(const double & publish_rate_in_seconds,
     componentManager->AddComponent(stats_bridge);
 
     stats_bridge->AddIntervalStatisticsPublisher(ros_namespace + "publishers", pub_bridge->GetName());
+    pub_bridge->AddLatencyStatisticsPublisher(ros_namespace + "publishers/latency_statistics");
     stats_bridge->AddIntervalStatisticsPublisher(ros_namespace + "tf_broadcast", tf_bridge->GetName());
     stats_bridge->AddIntervalStatisticsPublisher(ros_namespace + "spin", spin_bridge->GetName());
 
+    // timing histograms for IO, arms, teleops and bridges, tasks are
+    // added in Connect once all bridges are created
+    mTimingMonitor = new dvrk::timing_monitor(bridgeName + "_timing");
+    componentManager->AddComponent(mTimingMonitor);
+    stats_bridge->AddTimingStatisticsPublisher(mTimingMonitor, ros_namespace + "timing_statistics");
+
+    // applies and reports thread settings, tasks are added in Connect
+    mThreadConfigurator = new dvrk::thread_configurator(bridgeName + "_threads");
+    componentManager->AddComponent(mThreadConfigurator);
+
+    mBridges["publishers"] = pub_bridge;
+    mBridges["tf_broadcast"] = tf_bridge;
+    mBridges["spin"] = spin_bridge;
+    mBridges["stats"] = stats_bridge;
     mBridgeName = pub_bridge->GetName();
     mTfBridgeName = tf_bridge->GetName();
 
     if (mConsole->mHasIO) {
-        dvrk::add_topics_io(*pub_bridge, mNameSpace + "io", version);
+        mProfiler.Begin("add_topics_io");
+        dvrk::add_topics_io(*pub_bridge, mNameSpace + "io", versions);
     }
 
     const mtsIntuitiveResearchKitConsole::ArmList::iterator
@@ -81,33 +203,46 @@ dvrk::console::console(const double & publish_rate_in_seconds,
          ++armIter) {
         const std::string name = armIter->first;
         const std::string armNameSpace = mNameSpace + name;
+        mProfiler.Begin("add_topics " + name);
+        // use a separate bridge, i.e. thread, for each arm
+        dvrk::bridge * arm_bridge = pub_bridge;
+        if (bridge_per_arm) {
+            std::string armBridgeName = bridgeName + "_" + name;
+            std::replace(armBridgeName.begin(), armBridgeName.end(), '-', '_');
+            std::replace(armBridgeName.begin(), armBridgeName.end(), '.', '_');
+            arm_bridge = create_publish_bridge(armBridgeName, publish_rate_in_seconds, defer_advertisement);
+            componentManager->AddComponent(arm_bridge);
+            stats_bridge->AddIntervalStatisticsPublisher(armNameSpace + "/publishers", arm_bridge->GetName());
+            arm_bridge->AddLatencyStatisticsPublisher(armNameSpace + "/publishers/latency_statistics");
+            mBridges[name] = arm_bridge;
+        }
         switch (armIter->second->mType) {
         case mtsIntuitiveResearchKitConsole::Arm::ARM_MTM:
         case mtsIntuitiveResearchKitConsole::Arm::ARM_MTM_DERIVED:
             dvrk::add_tf_arm(*tf_bridge, name);
-            dvrk::add_topics_mtm(*pub_bridge, armNameSpace, name, version);
+            dvrk::add_topics_mtm(*arm_bridge, armNameSpace, name, versions);
             break;
         case mtsIntuitiveResearchKitConsole::Arm::ARM_MTM_GENERIC:
-            dvrk::add_topics_mtm_generic(*pub_bridge, armNameSpace, name, version);
+            dvrk::add_topics_mtm_generic(*arm_bridge, armNameSpace, name, versions);
             break;
         case mtsIntuitiveResearchKitConsole::Arm::ARM_ECM:
         case mtsIntuitiveResearchKitConsole::Arm::ARM_ECM_DERIVED:
             dvrk::add_tf_arm(*tf_bridge, name);
-            dvrk::add_topics_ecm(*pub_bridge, armNameSpace, name, version);
+            dvrk::add_topics_ecm(*arm_bridge, armNameSpace, name, versions);
             if (armIter->second->mSimulation
                 == mtsIntuitiveResearchKitConsole::Arm::SIMULATION_NONE) {
-                dvrk::add_topics_ecm_io(*pub_bridge, armNameSpace,
-                                        name, version);
+                dvrk::add_topics_ecm_io(*arm_bridge, armNameSpace,
+                                        name, versions);
             }
             break;
         case mtsIntuitiveResearchKitConsole::Arm::ARM_PSM:
         case mtsIntuitiveResearchKitConsole::Arm::ARM_PSM_DERIVED:
             dvrk::add_tf_arm(*tf_bridge, name);
-            dvrk::add_topics_psm(*pub_bridge, armNameSpace, name, version);
+            dvrk::add_topics_psm(*arm_bridge, armNameSpace, name, versions);
             if (armIter->second->mSimulation
                 == mtsIntuitiveResearchKitConsole::Arm::SIMULATION_NONE) {
-                dvrk::add_topics_psm_io(*pub_bridge, armNameSpace,
-                                        name, version);
+                dvrk::add_topics_psm_io(*arm_bridge, armNameSpace,
+                                        name, versions);
             }
             break;
         case mtsIntuitiveResearchKitConsole::Arm::ARM_SUJ:
@@ -115,10 +250,10 @@ dvrk::console::console(const double & publish_rate_in_seconds,
             dvrk::add_tf_suj(*tf_bridge, "PSM2");
             dvrk::add_tf_suj(*tf_bridge, "PSM3");
             dvrk::add_tf_suj(*tf_bridge, "ECM");
-            dvrk::add_topics_suj(*pub_bridge, mNameSpace + "SUJ/PSM1", "PSM1", version);
-            dvrk::add_topics_suj(*pub_bridge, mNameSpace + "SUJ/PSM2", "PSM2", version);
-            dvrk::add_topics_suj(*pub_bridge, mNameSpace + "SUJ/PSM3", "PSM3", version);
-            dvrk::add_topics_suj(*pub_bridge, mNameSpace + "SUJ/ECM", "ECM", version);
+            dvrk::add_topics_suj(*arm_bridge, mNameSpace + "SUJ/PSM1", "PSM1", versions);
+            dvrk::add_topics_suj(*arm_bridge, mNameSpace + "SUJ/PSM2", "PSM2", versions);
+            dvrk::add_topics_suj(*arm_bridge, mNameSpace + "SUJ/PSM3", "PSM3", versions);
+            dvrk::add_topics_suj(*arm_bridge, mNameSpace + "SUJ/ECM", "ECM", versions);
         default:
             break;
         }
@@ -133,10 +268,12 @@ dvrk::console::console(const double & publish_rate_in_seconds,
         const std::string name = teleopIter->first;
         std::string topic_name = teleopIter->first;
         std::replace(topic_name.begin(), topic_name.end(), '-', '_');
-        dvrk::add_topics_teleop(*pub_bridge, mNameSpace + topic_name, name, version);
+        mProfiler.Begin("add_topics_teleop " + name);
+        dvrk::add_topics_teleop(*pub_bridge, mNameSpace + topic_name, name, versions);
     }
 
     // digital inputs
+    mProfiler.Begin("add digital inputs");
     const std::string footPedalsNameSpace = mNameSpace + "footpedals/";
     typedef mtsIntuitiveResearchKitConsole::DInputSourceType DInputSourceType;
     const DInputSourceType::const_iterator inputsEnd = mConsole->mDInputSources.end();
@@ -156,7 +293,9 @@ dvrk::console::console(const double & publish_rate_in_seconds,
              footPedalsNameSpace + lowerName);
     }
 
-    dvrk::add_topics_console(*pub_bridge, mNameSpace + "console", version);
+    mProfiler.Begin("add_topics_console");
+    dvrk::add_topics_console(*pub_bridge, mNameSpace + "console", versions);
+    mProfiler.End();
 }
 
 void dvrk::console::Configure(const std::string & jsonFile)
@@ -174,6 +313,102 @@ void dvrk::console::Configure(const std::string & jsonFile)
 
     mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
 
+    const BridgesType::iterator bridgesEnd = mBridges.end();
+    BridgesType::iterator bridge;
+
+    // lazy publishing is on by default, i.e. topics without subscribers are not published
+    const Json::Value lazy = jsonConfig["lazy-publishing"];
+    if (!lazy.empty()) {
+        for (bridge = mBridges.begin(); bridge != bridgesEnd; ++bridge) {
+            bridge->second->SetLazy(lazy.asBool());
+        }
+    }
+
+    // periods for rate classes, e.g. "publish-periods": {"medium": 0.05, "slow": 0.5}
+    const Json::Value periods = jsonConfig["publish-periods"];
+    const Json::Value::Members periodNames = periods.getMemberNames();
+    for (Json::Value::Members::const_iterator name = periodNames.begin();
+         name != periodNames.end();
+         ++name) {
+        dvrk_topics_rate::rate rate;
+        try {
+            rate = dvrk_topics_rate::rateFromString(*name);
+        } catch (std::exception &) {
+            std::cerr << "Configure: invalid rate class \"" << *name << "\" in \"publish-periods\"" << std::endl;
+            return;
+        }
+        for (bridge = mBridges.begin(); bridge != bridgesEnd; ++bridge) {
+            bridge->second->SetRatePeriod(rate, periods[*name].asDouble());
+        }
+    }
+
+    // rate class for topics, e.g. "topic-rates": {"*jacobian*": "fast", "PSM1/twist_body_current": "slow"}
+    const Json::Value topics = jsonConfig["topic-rates"];
+    const Json::Value::Members topicNames = topics.getMemberNames();
+    for (Json::Value::Members::const_iterator name = topicNames.begin();
+         name != topicNames.end();
+         ++name) {
+        const std::string rateName = topics[*name].asString();
+        dvrk_topics_rate::rate rate;
+        try {
+            rate = dvrk_topics_rate::rateFromString(rateName);
+        } catch (std::exception &) {
+            std::cerr << "Configure: invalid rate class \"" << rateName << "\" for topic \""
+                      << *name << "\" in \"topic-rates\"" << std::endl;
+            return;
+        }
+        size_t found = 0;
+        for (bridge = mBridges.begin(); bridge != bridgesEnd; ++bridge) {
+            found += bridge->second->SetTopicRate(*name, rate);
+        }
+        if (found == 0) {
+            std::cerr << "Warning: no topic found matching \"" << *name << "\" in \"topic-rates\"" << std::endl;
+        }
+    }
+
+    // publish on change, e.g. "topic-on-change": {"SUJ/*": 0.001, "state_joint_current": 0.0}
+    // the value is the deadband, 0 to compare timestamps only
+    const Json::Value onChange = jsonConfig["topic-on-change"];
+    const Json::Value::Members onChangeNames = onChange.getMemberNames();
+    for (Json::Value::Members::const_iterator name = onChangeNames.begin();
+         name != onChangeNames.end();
+         ++name) {
+        size_t found = 0;
+        for (bridge = mBridges.begin(); bridge != bridgesEnd; ++bridge) {
+            found += bridge->second->SetTopicOnChange(*name, onChange[*name].asDouble());
+        }
+        if (found == 0) {
+            std::cerr << "Warning: no topic found matching \"" << *name << "\" in \"topic-on-change\"" << std::endl;
+        }
+    }
+
+    // remove topics, e.g. "topic-disabled": ["*jacobian*"] if clients
+    // use the query_jacobian service instead
+    const Json::Value disabled = jsonConfig["topic-disabled"];
+    for (unsigned int index = 0; index < disabled.size(); ++index) {
+        const std::string name = disabled[index].asString();
+        size_t found = 0;
+        for (bridge = mBridges.begin(); bridge != bridgesEnd; ++bridge) {
+            found += bridge->second->RemoveTopics(name);
+        }
+        if (found == 0) {
+            std::cerr << "Warning: no topic found matching \"" << name << "\" in \"topic-disabled\"" << std::endl;
+        }
+    }
+
+    // timing histograms, e.g. "timing-statistics": {"overrun-ratio": 1.5, "log-period": 60}
+    // log period 0 turns off the summary in the cisst log
+    const Json::Value timing = jsonConfig["timing-statistics"];
+    if (!timing.empty()) {
+        const double overrunRatio = timing.get("overrun-ratio", 1.2).asDouble();
+        if (overrunRatio < 1.0) {
+            std::cerr << "Configure: \"overrun-ratio\" in \"timing-statistics\" must be at least 1" << std::endl;
+            return;
+        }
+        mTimingMonitor->SetOverrunRatio(overrunRatio);
+        mTimingMonitor->SetLogPeriod(timing.get("log-period", 10.0).asDouble());
+    }
+
     // look for io-interfaces
     const Json::Value interfaces = jsonConfig["io-interfaces"];
     for (unsigned int index = 0; index < interfaces.size(); ++index) {
@@ -185,19 +420,162 @@ void dvrk::console::Configure(const std::string & jsonFile)
                       << "or it doesn't have an IO component, no ROS bridge connected" << std::endl
                       << "for this IO." << std::endl;
         } else {
-            mtsROSBridge * rosIOBridge = new mtsROSBridge(bridgeNamePrefix + name, period, true);
+            // IO topics are publishers only, callbacks are processed by the spin bridge
+            dvrk::bridge * rosIOBridge = new dvrk::bridge(bridgeNamePrefix + name, period, false, true);
+            rosIOBridge->SetDeferAdvertisement(mDeferAdvertisement);
             dvrk::add_topics_io(*rosIOBridge,
                                 mNameSpace + name + "/io/",
-                                name, mVersion);
+                                name, mVersions);
+            // optional capture of all IO samples, e.g. "capture": {"samples-per-chunk": 20}
+            const Json::Value capture = interfaces[index]["capture"];
+            if (!capture.empty()) {
+                const size_t samplesPerChunk = capture.get("samples-per-chunk", 20).asUInt();
+                const size_t bufferSize = capture.get("buffer-size", 2000).asUInt();
+                dvrk::add_topics_io_capture(*rosIOBridge,
+                                            mNameSpace + name + "/io",
+                                            name, samplesPerChunk, bufferSize);
+                mIOCaptures.push_back(name);
+            }
+            rosIOBridge->AddLatencyStatisticsPublisher(mNameSpace + name + "/io/latency_statistics");
             componentManager->AddComponent(rosIOBridge);
             mIOInterfaces.push_back(name);
+            mBridges[name + "/io"] = rosIOBridge;
+        }
+    }
+
+    // state recorders, one file per arm, e.g. "recorder": {"file-prefix": "/tmp/session-", "duration": 600, "arms": ["PSM1"]}
+    const Json::Value recorder = jsonConfig["recorder"];
+    if (!recorder.empty()) {
+        const std::string filePrefix = recorder.get("file-prefix", "dvrk-state-").asString();
+        const double duration = recorder.get("duration", 600.0).asDouble();
+        std::list<std::string> armNames;
+        if (!arm_names_from_json(recorder["arms"], mConsole, "recorder", armNames)) {
+            return;
+        }
+        const std::list<std::string>::const_iterator armNamesEnd = armNames.end();
+        std::list<std::string>::const_iterator armName;
+        for (armName = armNames.begin();
+             armName != armNamesEnd;
+             ++armName) {
+            const mtsIntuitiveResearchKitConsole::ArmList::const_iterator arm = mConsole->mArms.find(*armName);
+            // one record per arm cycle
+            const mtsTask * armTask =
+                dynamic_cast<const mtsTask *>(componentManager->GetComponent(arm->second->ComponentName()));
+            if (!armTask || (armTask->GetPeriodicity() <= 0.0)) {
+                std::cerr << "Configure: arm \"" << *armName << "\" in \"recorder\" is not a periodic task" << std::endl;
+                return;
+            }
+            const double period = armTask->GetPeriodicity();
+            dvrk::state_recorder * stateRecorder =
+                new dvrk::state_recorder(*armName + "-recorder",
+                                         filePrefix + *armName + ".dvrk-state",
+                                         static_cast<size_t>(duration / period) + 1,
+                                         period);
+            componentManager->AddComponent(stateRecorder);
+            mRecorders[*armName] = stateRecorder->GetName();
+        }
+    }
+
+    // latest arm states in shared memory, e.g. "shared-memory": {"name": "/dvrk_state", "arms": ["PSM1"]}
+    const Json::Value sharedMemory = jsonConfig["shared-memory"];
+    if (!sharedMemory.empty()) {
+        std::list<std::string> armNames;
+        if (!arm_names_from_json(sharedMemory["arms"], mConsole, "shared-memory", armNames)) {
+            return;
+        }
+        mSharedState = new dvrk::shared_state_writer("dVRKSharedState",
+                                                     sharedMemory.get("name", DVRK_SHARED_STATE_DEFAULT_NAME).asString());
+        const std::list<std::string>::const_iterator armNamesEnd = armNames.end();
+        std::list<std::string>::const_iterator armName;
+        for (armName = armNames.begin();
+             armName != armNamesEnd;
+             ++armName) {
+            if (!mSharedState->AddArm(*armName)) {
+                std::cerr << "Configure: failed to add arm \"" << *armName << "\" in \"shared-memory\"" << std::endl;
+                return;
+            }
+            mSharedStateArms.push_back(*armName);
+        }
+        componentManager->AddComponent(mSharedState);
+    }
+
+    // thread settings for bridges, e.g. "bridges": {"spin": {"cpus": [3], "priority": 80}, "PSM1": {"cpus": 2}}
+    const Json::Value bridges = jsonConfig["bridges"];
+    const Json::Value::Members bridgeNames = bridges.getMemberNames();
+    for (Json::Value::Members::const_iterator name = bridgeNames.begin();
+         name != bridgeNames.end();
+         ++name) {
+        bridge = mBridges.find(*name);
+        if (bridge == bridgesEnd) {
+            std::cerr << "Configure: no bridge named \"" << *name << "\" in \"bridges\"" << std::endl;
+            return;
+        }
+        dvrk::thread_settings settings;
+        if (!settings.FromJSON(bridges[*name])) {
+            std::cerr << "Configure: invalid thread settings for bridge \"" << *name << "\" in \"bridges\"" << std::endl;
+            return;
+        }
+        bridge->second->SetThreadSettings(settings);
+        mBridgesWithThreadSettings.insert(*name);
+    }
+
+    // thread settings per component class, e.g. "threads": {"io": {"cpus": 1, "priority": 90},
+    // "bridges": {"cpus": [2, 3], "policy": "other", "nice": 5}}, bridges set in "bridges" are not affected
+    const Json::Value threads = jsonConfig["threads"];
+    const Json::Value::Members threadClasses = threads.getMemberNames();
+    for (Json::Value::Members::const_iterator name = threadClasses.begin();
+         name != threadClasses.end();
+         ++name) {
+        const ThreadSettingsType::const_iterator current = mThreadSettings.find(*name);
+        dvrk::thread_settings settings;
+        if (current != mThreadSettings.end()) {
+            settings = current->second;
+        }
+        if (!settings.FromJSON(threads[*name])
+            || !SetThreadSettings(*name, settings)) {
+            std::cerr << "Configure: invalid thread settings for \"" << *name << "\" in \"threads\"" << std::endl
+                      << "component classes are \"io\", \"arms\", \"teleop\" and \"bridges\"" << std::endl;
+            return;
+        }
+    }
+
+    // lock all pages in memory, e.g. "lock-memory": true
+    if (jsonConfig.get("lock-memory", false).asBool()) {
+        std::string message;
+        if (!dvrk::lock_memory(message)) {
+            std::cerr << "Configure: " << message << std::endl;
+            return;
+        }
+        std::cout << "Configure: memory locked" << std::endl;
+    }
+
+    // publish arm topics when the arm has run, value is the decimation
+    // e.g. "publish-on-arm-event": {"PSM1": 1, "MTML": 2}
+    const Json::Value onArmEvent = jsonConfig["publish-on-arm-event"];
+    const Json::Value::Members onArmEventNames = onArmEvent.getMemberNames();
+    for (Json::Value::Members::const_iterator name = onArmEventNames.begin();
+         name != onArmEventNames.end();
+         ++name) {
+        bridge = mBridges.find(*name);
+        if ((bridge == bridgesEnd)
+            || (mConsole->mArms.find(*name) == mConsole->mArms.end())) {
+            std::cerr << "Configure: no bridge for arm \"" << *name << "\" in \"publish-on-arm-event\"" << std::endl
+                      << "make sure the arm exists and the console uses one bridge per arm (-b)" << std::endl;
+            return;
+        }
+        const int decimation = onArmEvent[*name].asInt();
+        if (decimation < 1) {
+            std::cerr << "Configure: decimation for \"" << *name << "\" in \"publish-on-arm-event\" must be at least 1" << std::endl;
+            return;
         }
+        bridge->second->SetTrigger(*name + "-trigger", decimation);
     }
 }
 
 void dvrk::console::Connect(void)
 {
     if (mConsole->mHasIO) {
+        mProfiler.Begin("connect_bridge_io");
         dvrk::connect_bridge_io(mBridgeName, mConsole->mIOComponentName);
     }
 
@@ -208,28 +586,40 @@ void dvrk::console::Connect(void)
          armIter != armEnd;
          ++armIter) {
         const std::string name = armIter->first;
+        const std::string armBridgeName = ArmBridgeName(name);
+        mProfiler.Begin("connect_bridge " + name);
+        // publication triggered by the arm's run event
+        const BridgesType::const_iterator armBridge = mBridges.find(name);
+        if ((armBridge != mBridges.end()) && armBridge->second->Triggered()) {
+            mtsManagerLocal::GetInstance()->Connect(armBridgeName, name + "-trigger",
+                                                    armIter->second->ComponentName(), "ExecOut");
+        }
         switch (armIter->second->mType) {
         case mtsIntuitiveResearchKitConsole::Arm::ARM_MTM:
         case mtsIntuitiveResearchKitConsole::Arm::ARM_MTM_DERIVED:
             dvrk::connect_tf_arm(mTfBridgeName, name,
                                  armIter->second->ComponentName(),
                                  armIter->second->InterfaceName());
-        case mtsIntuitiveResearchKitConsole::Arm::ARM_MTM_GENERIC:
-            dvrk::connect_bridge_mtm(mBridgeName, name,
+            dvrk::connect_bridge_mtm(armBridgeName, name,
                                      armIter->second->ComponentName(),
                                      armIter->second->InterfaceName());
             break;
+        case mtsIntuitiveResearchKitConsole::Arm::ARM_MTM_GENERIC:
+            dvrk::connect_bridge_mtm_generic(armBridgeName, name,
+                                             armIter->second->ComponentName(),
+                                             armIter->second->InterfaceName());
+            break;
         case mtsIntuitiveResearchKitConsole::Arm::ARM_ECM:
         case mtsIntuitiveResearchKitConsole::Arm::ARM_ECM_DERIVED:
             dvrk::connect_tf_arm(mTfBridgeName, name,
                                  armIter->second->ComponentName(),
                                  armIter->second->InterfaceName());
-            dvrk::connect_bridge_ecm(mBridgeName, name,
+            dvrk::connect_bridge_ecm(armBridgeName, name,
                                      armIter->second->ComponentName(),
                                      armIter->second->InterfaceName());
             if (armIter->second->mSimulation
                 == mtsIntuitiveResearchKitConsole::Arm::SIMULATION_NONE) {
-                dvrk::connect_bridge_ecm_io(mBridgeName, name,
+                dvrk::connect_bridge_ecm_io(armBridgeName, name,
                                             armIter->second->IOComponentName());
             }
             break;
@@ -238,12 +628,12 @@ void dvrk::console::Connect(void)
             dvrk::connect_tf_arm(mTfBridgeName, name,
                                  armIter->second->ComponentName(),
                                  armIter->second->InterfaceName());
-            dvrk::connect_bridge_psm(mBridgeName, name,
+            dvrk::connect_bridge_psm(armBridgeName, name,
                                      armIter->second->ComponentName(),
                                      armIter->second->InterfaceName());
             if (armIter->second->mSimulation
                 == mtsIntuitiveResearchKitConsole::Arm::SIMULATION_NONE) {
-                dvrk::connect_bridge_psm_io(mBridgeName, name,
+                dvrk::connect_bridge_psm_io(armBridgeName, name,
                                             armIter->second->IOComponentName());
             }
             break;
@@ -252,10 +642,10 @@ void dvrk::console::Connect(void)
             dvrk::connect_tf_suj(mTfBridgeName, name, "PSM2");
             dvrk::connect_tf_suj(mTfBridgeName, name, "PSM3");
             dvrk::connect_tf_suj(mTfBridgeName, name, "ECM");
-            dvrk::connect_bridge_suj(mBridgeName, name, "PSM1");
-            dvrk::connect_bridge_suj(mBridgeName, name, "PSM2");
-            dvrk::connect_bridge_suj(mBridgeName, name, "PSM3");
-            dvrk::connect_bridge_suj(mBridgeName, name, "ECM");
+            dvrk::connect_bridge_suj(armBridgeName, name, "PSM1");
+            dvrk::connect_bridge_suj(armBridgeName, name, "PSM2");
+            dvrk::connect_bridge_suj(armBridgeName, name, "PSM3");
+            dvrk::connect_bridge_suj(armBridgeName, name, "ECM");
         default:
             break;
         }
@@ -268,10 +658,12 @@ void dvrk::console::Connect(void)
          teleopIter != teleopsEnd;
          ++teleopIter) {
         const std::string name = teleopIter->first;
+        mProfiler.Begin("connect_bridge_teleop " + name);
         dvrk::connect_bridge_teleop(mBridgeName, name);
     }
 
     // connect foot pedal, all arms use same
+    mProfiler.Begin("connect digital inputs");
     mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
     typedef mtsIntuitiveResearchKitConsole::DInputSourceType DInputSourceType;
     const DInputSourceType::const_iterator inputsEnd = mConsole->mDInputSources.end();
@@ -284,9 +676,39 @@ void dvrk::console::Connect(void)
     }
 
     // connect console bridge
+    mProfiler.Begin("connect_bridge_console");
     dvrk::connect_bridge_console(mBridgeName, mConsole->GetName());
 
+    // state recorders
+    const RecordersType::const_iterator recordersEnd = mRecorders.end();
+    RecordersType::const_iterator recorder;
+    for (recorder = mRecorders.begin();
+         recorder != recordersEnd;
+         ++recorder) {
+        const mtsIntuitiveResearchKitConsole::Arm * arm = mConsole->mArms[recorder->first];
+        mtsManagerLocal::GetInstance()->Connect(recorder->second, "Arm",
+                                                arm->ComponentName(), arm->InterfaceName());
+        mtsManagerLocal::GetInstance()->Connect(recorder->second, "Run",
+                                                arm->ComponentName(), "ExecOut");
+    }
+
+    // shared memory state
+    if (mSharedState) {
+        const std::list<std::string>::const_iterator armNamesEnd = mSharedStateArms.end();
+        std::list<std::string>::const_iterator armName;
+        for (armName = mSharedStateArms.begin();
+             armName != armNamesEnd;
+             ++armName) {
+            const mtsIntuitiveResearchKitConsole::Arm * arm = mConsole->mArms[*armName];
+            mtsManagerLocal::GetInstance()->Connect(mSharedState->GetName(), *armName,
+                                                    arm->ComponentName(), arm->InterfaceName());
+            mtsManagerLocal::GetInstance()->Connect(mSharedState->GetName(), *armName + "-run",
+                                                    arm->ComponentName(), "ExecOut");
+        }
+    }
+
     // ros wrappers for IO
+    mProfiler.Begin("connect_bridge_io interfaces");
     const std::list<std::string>::const_iterator end = mIOInterfaces.end();
     std::list<std::string>::const_iterator iter;
     for (iter = mIOInterfaces.begin();
@@ -296,4 +718,102 @@ void dvrk::console::Connect(void)
         const std::string ioComponentName = mConsole->GetArmIOComponentName(*iter);
         dvrk::connect_bridge_io(bridgeName, ioComponentName, *iter);
     }
+    const std::list<std::string>::const_iterator endCapture = mIOCaptures.end();
+    for (iter = mIOCaptures.begin();
+         iter != endCapture;
+         iter++) {
+        const std::string bridgeName = bridgeNamePrefix + *iter;
+        const std::string ioComponentName = mConsole->GetArmIOComponentName(*iter);
+        dvrk::connect_bridge_io_capture(bridgeName, ioComponentName, *iter);
+    }
+
+    // thread settings per component class, bridges apply their own
+    // settings when they start
+    mProfiler.Begin("connect thread configurator");
+    const dvrk::thread_settings & ioSettings = mThreadSettings["io"];
+    const dvrk::thread_settings & armSettings = mThreadSettings["arms"];
+    const dvrk::thread_settings & teleopSettings = mThreadSettings["teleop"];
+    const dvrk::thread_settings & bridgeSettings = mThreadSettings["bridges"];
+    if (mConsole->mHasIO) {
+        add_thread_task(mThreadConfigurator, mConsole->mIOComponentName,
+                        ioSettings, !ioSettings.IsDefault());
+    }
+    for (armIter = mConsole->mArms.begin();
+         armIter != armEnd;
+         ++armIter) {
+        add_thread_task(mThreadConfigurator, armIter->second->ComponentName(),
+                        armSettings, !armSettings.IsDefault());
+    }
+    for (teleopIter = mConsole->mTeleopsPSM.begin();
+         teleopIter != teleopsEnd;
+         ++teleopIter) {
+        add_thread_task(mThreadConfigurator, teleopIter->first,
+                        teleopSettings, !teleopSettings.IsDefault());
+    }
+    if (mConsole->mTeleopECM) {
+        add_thread_task(mThreadConfigurator, mConsole->mTeleopECM->Name(),
+                        teleopSettings, !teleopSettings.IsDefault());
+    }
+    for (BridgesType::const_iterator bridge = mBridges.begin();
+         bridge != mBridges.end();
+         ++bridge) {
+        if (!bridgeSettings.IsDefault()
+            && (mBridgesWithThreadSettings.find(bridge->first) == mBridgesWithThreadSettings.end())) {
+            bridge->second->SetThreadSettings(bridgeSettings);
+        }
+        add_thread_task(mThreadConfigurator, bridge->second->GetName(),
+                        bridgeSettings, false);
+    }
+
+    // timing histograms
+    mProfiler.Begin("connect timing monitor");
+    if (mConsole->mHasIO) {
+        add_timing_task(mTimingMonitor, mConsole->mIOComponentName);
+    }
+    for (armIter = mConsole->mArms.begin();
+         armIter != armEnd;
+         ++armIter) {
+        add_timing_task(mTimingMonitor, armIter->second->ComponentName());
+    }
+    for (teleopIter = mConsole->mTeleopsPSM.begin();
+         teleopIter != teleopsEnd;
+         ++teleopIter) {
+        add_timing_task(mTimingMonitor, teleopIter->first);
+    }
+    if (mConsole->mTeleopECM) {
+        add_timing_task(mTimingMonitor, mConsole->mTeleopECM->Name());
+    }
+    const BridgesType::const_iterator bridgesEnd = mBridges.end();
+    BridgesType::const_iterator bridge;
+    for (bridge = mBridges.begin();
+         bridge != bridgesEnd;
+         ++bridge) {
+        add_timing_task(mTimingMonitor, bridge->second->GetName());
+    }
+    mProfiler.End();
+}
+
+bool dvrk::console::SetThreadSettings(const std::string & component_class,
+                                      const dvrk::thread_settings & settings)
+{
+    const ThreadSettingsType::iterator current = mThreadSettings.find(component_class);
+    if (current == mThreadSettings.end()) {
+        return false;
+    }
+    current->second = settings;
+    return true;
+}
+
+bool dvrk::console::ReportThreadSettings(std::ostream & output_stream) const
+{
+    return mThreadConfigurator->Report(output_stream);
+}
+
+const std::string & dvrk::console::ArmBridgeName(const std::string & arm_name) const
+{
+    const BridgesType::const_iterator bridge = mBridges.find(arm_name);
+    if (bridge == mBridges.end()) {
+        return mBridgeName;
+    }
+    return bridge->second->GetName();
 }
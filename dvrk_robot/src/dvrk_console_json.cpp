@@ -37,6 +37,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <ros/ros.h>
 #include <cisst_ros_bridge/mtsROSBridge.h>
 #include <dvrk_utilities/dvrk_console.h>
+#include <dvrk_utilities/dvrk_async_log_channel.h>
 
 void fileExists(const std::string & description, const std::string & filename)
 {
@@ -61,11 +62,19 @@ int main(int argc, char ** argv)
     cmnLogger::SetMaskFunction(CMN_LOG_ALLOW_ALL);
     cmnLogger::SetMaskClassMatching("mtsIntuitiveResearchKit", CMN_LOG_ALLOW_ALL);
     cmnLogger::AddChannel(std::cerr, CMN_LOG_ALLOW_ERRORS_AND_WARNINGS);
-    // add log file with date so logs don't get overwritten
+    // add log file with date so logs don't get overwritten.  The
+    // file is written by a low priority thread so components logging
+    // from their periodic thread never wait for the file.
     std::string currentDateTime;
     osaGetDateTimeString(currentDateTime);
-    std::ofstream logFileStream(std::string("cisstLog-" + currentDateTime + ".txt").c_str());
-    cmnLogger::AddChannel(logFileStream);
+    dvrk::async_log_channel logChannel("cisstLog-" + currentDateTime + ".txt");
+    const bool logFileStarted = logChannel.Start();
+    if (logFileStarted) {
+        cmnLogger::AddChannel(logChannel.Stream());
+    } else {
+        std::cerr << "Error: failed to start log file cisstLog-" << currentDateTime
+                  << ".txt, logging to console only" << std::endl;
+    }
     cmnLogger::HaltDefaultLog(); // stop log to default cisstLog.txt
 
     // ---- WARNING: hack to remove ros args ----
@@ -81,7 +90,9 @@ int main(int argc, char ** argv)
     double rosPeriod = 10.0 * cmn_ms;
     double tfPeriod = 20.0 * cmn_ms;
     std::list<std::string> jsonIOConfigFiles;
-    std::string versionString = "v1_4_0";
+    std::list<std::string> versionStrings;
+    // thread settings per component class
+    std::map<std::string, std::string> threadSettings;
     typedef std::list<std::string> managerConfigType;
     managerConfigType managerConfig;
 
@@ -94,7 +105,7 @@ int main(int argc, char ** argv)
                               cmnCommandLineOptions::OPTIONAL_OPTION, &rosNamespace);
 
     options.AddOptionOneValue("p", "ros-period",
-                              "period in seconds to read all arms/teleop components and publish (default 0.01, 10 ms, 100Hz).  There is no point to have a period higher than the arm component's period",
+                              "period in seconds to read all arms/teleop components and publish the fast rate topics (default 0.01, 10 ms, 100Hz).  There is no point to have a period higher than the arm component's period",
                               cmnCommandLineOptions::OPTIONAL_OPTION, &rosPeriod);
 
     options.AddOptionOneValue("P", "tf-ros-period",
@@ -102,15 +113,43 @@ int main(int argc, char ** argv)
                               cmnCommandLineOptions::OPTIONAL_OPTION, &tfPeriod);
 
     options.AddOptionMultipleValues("i", "ros-io-config",
-                                    "json config file to configure ROS bridges to collect low level data (IO)",
+                                    "json config file to configure ROS bridges to collect low level data (IO) and set publish rates",
                                     cmnCommandLineOptions::OPTIONAL_OPTION, &jsonIOConfigFiles);
 
     options.AddOptionNoValue("t", "text-only",
                              "text only interface, do not create Qt widgets");
 
-    options.AddOptionOneValue("c", "compatibility",
-                              "compatibility mode, e.g. \"v1_3_0\", \"v1_4_0\"",
-                              cmnCommandLineOptions::OPTIONAL_OPTION, &versionString);
+    options.AddOptionNoValue("b", "bridge-per-arm",
+                             "use a separate ROS bridge (i.e. thread) to publish each arm's topics");
+
+    options.AddOptionNoValue("D", "defer-advertisement",
+                             "advertise topics not published at the fast rate after the components are started");
+
+    options.AddOptionNoValue("s", "startup-profile",
+                             "print the time spent in each startup step");
+
+    options.AddOptionMultipleValues("c", "compatibility",
+                                    "compatibility mode, e.g. \"v1_3_0\", \"v1_4_0\" (default), \"crtk_alpha\", \"compact\" or \"compact_float32\".  Can be used multiple times to publish topics for multiple versions, data read from the arms is shared by all versions.  Compact versions only add joint states, use them along another version",
+                                    cmnCommandLineOptions::OPTIONAL_OPTION, &versionStrings);
+
+    options.AddOptionOneValue("I", "io-thread",
+                              "thread settings for the IO component, policy[:value][@cpus] where value is the priority for \"fifo\" or the nice value for \"other\", e.g. \"fifo:90@1\"",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &threadSettings["io"]);
+
+    options.AddOptionOneValue("A", "arm-thread",
+                              "thread settings for all arm components, see -I",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &threadSettings["arms"]);
+
+    options.AddOptionOneValue("T", "teleop-thread",
+                              "thread settings for all teleoperation components, see -I",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &threadSettings["teleop"]);
+
+    options.AddOptionOneValue("R", "ros-thread",
+                              "thread settings for all ROS bridges, see -I, e.g. \"other:5@2,3\" to keep ROS away from the control threads",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &threadSettings["bridges"]);
+
+    options.AddOptionNoValue("L", "lock-memory",
+                             "lock all current and future memory pages (mlockall) to avoid page faults in real-time threads");
 
     options.AddOptionMultipleValues("m", "component-manager",
                                     "JSON files to configure component manager",
@@ -127,18 +166,37 @@ int main(int argc, char ** argv)
     options.PrintParsedArguments(arguments);
     std::cout << "Options provided:" << std::endl << arguments;
 
-    // check version mode
-    dvrk_topics_version::version versionEnum;
-    try {
-        versionEnum = dvrk_topics_version::versionFromString(versionString);
-    } catch (std::exception e) {
-        std::cerr << "Compatibility mode " << versionString << " is invalid" << std::endl;
-        std::cerr << "Possible values are: ";
-        std::cerr << cmnData<std::vector<std::string> >::HumanReadable(dvrk_topics_version::versionVectorString());
-        std::cerr << std::endl;
-        return -1;
+    // check version modes
+    if (versionStrings.empty()) {
+        versionStrings.push_back("v1_4_0");
+    }
+    dvrk::topics_versions versions;
+    const std::list<std::string>::const_iterator versionsEnd = versionStrings.end();
+    std::list<std::string>::const_iterator versionString;
+    for (versionString = versionStrings.begin();
+         versionString != versionsEnd;
+         ++versionString) {
+        try {
+            versions.push_back(dvrk_topics_version::versionFromString(*versionString));
+        } catch (std::exception e) {
+            std::cerr << "Compatibility mode " << *versionString << " is invalid" << std::endl;
+            std::cerr << "Possible values are: ";
+            std::cerr << cmnData<std::vector<std::string> >::HumanReadable(dvrk_topics_version::versionVectorString());
+            std::cerr << std::endl;
+            return -1;
+        }
+        std::cout << "Using compatibility mode: " << *versionString << std::endl;
+    }
+
+    // lock memory as early as possible
+    if (options.IsSet("lock-memory")) {
+        std::string message;
+        if (!dvrk::lock_memory(message)) {
+            std::cerr << "Error: " << message << std::endl;
+            return -1;
+        }
+        std::cout << "Memory locked" << std::endl;
     }
-    std::cout << "Using compatibility mode: " << versionString << std::endl;
 
     const bool hasQt = !options.IsSet("text-only");
 
@@ -169,10 +227,12 @@ int main(int argc, char ** argv)
     // - rosPeriod is used to control publish rate
     // - tfPeriod is used to control tf broadcast rate
     //
-    // this also adds a mtsROSBridge that performs the ros::spinOnce
-    // in a separate thread as fast possible
+    // this also adds a bridge that processes ROS callbacks in a
+    // separate thread as soon as they are received
     dvrk::console * consoleROS = new dvrk::console(rosPeriod, tfPeriod, rosNamespace,
-                                                   console, versionEnum);
+                                                   console, versions,
+                                                   options.IsSet("bridge-per-arm"),
+                                                   options.IsSet("defer-advertisement"));
     // IOs
     const std::list<std::string>::const_iterator end = jsonIOConfigFiles.end();
     std::list<std::string>::const_iterator iter;
@@ -183,6 +243,24 @@ int main(int argc, char ** argv)
         consoleROS->Configure(*iter);
     }
 
+    // thread settings from command line override the JSON files
+    const std::map<std::string, std::string>::const_iterator threadSettingsEnd = threadSettings.end();
+    std::map<std::string, std::string>::const_iterator threadSetting;
+    for (threadSetting = threadSettings.begin();
+         threadSetting != threadSettingsEnd;
+         ++threadSetting) {
+        if (threadSetting->second.empty()) {
+            continue;
+        }
+        dvrk::thread_settings settings;
+        if (!settings.FromString(threadSetting->second)) {
+            std::cerr << "Thread settings \"" << threadSetting->second << "\" for "
+                      << threadSetting->first << " are invalid" << std::endl;
+            return -1;
+        }
+        consoleROS->SetThreadSettings(threadSetting->first, settings);
+    }
+
     consoleROS->Connect();
 
     // custom user component
@@ -205,8 +283,19 @@ int main(int argc, char ** argv)
     }
 
     //-------------- create the components ------------------
+    consoleROS->Profiler().Begin("CreateAllAndWait");
     componentManager->CreateAllAndWait(2.0 * cmn_s);
+    consoleROS->Profiler().Begin("StartAllAndWait");
     componentManager->StartAllAndWait(2.0 * cmn_s);
+    consoleROS->Profiler().End();
+    if (options.IsSet("startup-profile")) {
+        consoleROS->Profiler().Report(std::cout);
+    }
+
+    std::cout << "Thread settings:" << std::endl;
+    if (!consoleROS->ReportThreadSettings(std::cout)) {
+        std::cerr << "Warning: some thread settings couldn't be applied, see above" << std::endl;
+    }
 
     if (hasQt) {
         application->exec();
@@ -221,7 +310,14 @@ int main(int argc, char ** argv)
 
     // stop all logs
     cmnLogger::Kill();
-    cmnLogger::RemoveChannel(logFileStream);
+    if (logFileStarted) {
+        cmnLogger::RemoveChannel(logChannel.Stream());
+        logChannel.Stop();
+        if (logChannel.Dropped() > 0) {
+            std::cerr << "Warning: " << logChannel.Dropped()
+                      << " log line(s) dropped, see cisstLog-" << currentDateTime << ".txt" << std::endl;
+        }
+    }
 
     delete console;
     if (hasQt) {
@@ -0,0 +1,171 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-15
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// system
+#include <iostream>
+#include <sstream>
+
+// cisst/saw
+#include <cisstCommon/cmnPath.h>
+#include <sawIntuitiveResearchKit/mtsIntuitiveResearchKitConsole.h>
+
+#include <nodelet/nodelet.h>
+#include <pluginlib/class_list_macros.h>
+
+#include <ros/ros.h>
+#include <dvrk_utilities/dvrk_console.h>
+
+namespace dvrk {
+
+    /*! Nodelet version of dvrk_console_json, without Qt.  When
+      loaded in a nodelet manager, all the topics published by the
+      console's bridges are sent to subscribers in the same process
+      as shared pointers, i.e. without serialization nor copy.
+      Parameters (private namespace) are:
+      - config: console JSON configuration file (required)
+      - io_config: list of JSON files used for dvrk::console::Configure
+      - ros_namespace: default is "dvrk/"
+      - ros_period: publish period in seconds, default is 0.01
+      - tf_period: tf broadcast period in seconds, default is 0.02
+      - compatibility: topics version or list of versions, default
+        is "v1_4_0"
+      - bridge_per_arm: one publish bridge per arm, default is false
+      - defer_advertisement: advertise topics not published at the
+        fast rate after the components are started, default is false
+      - startup_profile: print the time spent in each startup step,
+        default is false */
+    class console_nodelet: public nodelet::Nodelet
+    {
+    public:
+        console_nodelet(void):
+            mConsole(0),
+            mConsoleROS(0)
+        {}
+
+        ~console_nodelet() {
+            if (mConsole) {
+                mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+                componentManager->KillAllAndWait(2.0 * cmn_s);
+                componentManager->Cleanup();
+                delete mConsole;
+                delete mConsoleROS;
+            }
+        }
+
+    protected:
+        void onInit(void) {
+            ros::NodeHandle & privateNodeHandle = getPrivateNodeHandle();
+
+            cmnLogger::AddChannel(std::cerr, CMN_LOG_ALLOW_ERRORS_AND_WARNINGS);
+
+            std::string jsonMainConfigFile;
+            if (!privateNodeHandle.getParam("config", jsonMainConfigFile)) {
+                NODELET_ERROR("dvrk console nodelet: parameter \"config\" is required");
+                return;
+            }
+            if (!cmnPath::Exists(jsonMainConfigFile)) {
+                NODELET_ERROR_STREAM("dvrk console nodelet: file not found " << jsonMainConfigFile);
+                return;
+            }
+            std::vector<std::string> jsonIOConfigFiles;
+            privateNodeHandle.getParam("io_config", jsonIOConfigFiles);
+            std::string rosNamespace;
+            privateNodeHandle.param<std::string>("ros_namespace", rosNamespace, "dvrk/");
+            std::vector<std::string> versionStrings;
+            if (!privateNodeHandle.getParam("compatibility", versionStrings)) {
+                std::string versionString;
+                privateNodeHandle.param<std::string>("compatibility", versionString, "v1_4_0");
+                versionStrings.push_back(versionString);
+            }
+            double rosPeriod, tfPeriod;
+            privateNodeHandle.param("ros_period", rosPeriod, 10.0 * cmn_ms);
+            privateNodeHandle.param("tf_period", tfPeriod, 20.0 * cmn_ms);
+            bool bridgePerArm, deferAdvertisement, startupProfile;
+            privateNodeHandle.param("bridge_per_arm", bridgePerArm, false);
+            privateNodeHandle.param("defer_advertisement", deferAdvertisement, false);
+            privateNodeHandle.param("startup_profile", startupProfile, false);
+
+            dvrk::topics_versions versions;
+            const std::vector<std::string>::const_iterator versionsEnd = versionStrings.end();
+            std::vector<std::string>::const_iterator versionString;
+            for (versionString = versionStrings.begin();
+                 versionString != versionsEnd;
+                 ++versionString) {
+                try {
+                    versions.push_back(dvrk_topics_version::versionFromString(*versionString));
+                } catch (std::exception &) {
+                    NODELET_ERROR_STREAM("dvrk console nodelet: compatibility mode " << *versionString << " is invalid");
+                    return;
+                }
+            }
+
+            mtsManagerLocal * componentManager = mtsManagerLocal::GetInstance();
+
+            mConsole = new mtsIntuitiveResearchKitConsole("console");
+            // Configure doesn't return a status, a console without arm
+            // means the configuration failed
+            mConsole->Configure(jsonMainConfigFile);
+            if (mConsole->mArms.empty()) {
+                NODELET_ERROR_STREAM("dvrk console nodelet: failed to configure console using " << jsonMainConfigFile);
+                delete mConsole;
+                mConsole = 0;
+                return;
+            }
+            componentManager->AddComponent(mConsole);
+            if (!mConsole->Connect()) {
+                NODELET_ERROR("dvrk console nodelet: failed to connect console");
+                componentManager->RemoveComponent(mConsole);
+                delete mConsole;
+                mConsole = 0;
+                return;
+            }
+
+            mConsoleROS = new dvrk::console(rosPeriod, tfPeriod, rosNamespace,
+                                            mConsole, versions, bridgePerArm,
+                                            deferAdvertisement);
+            const std::vector<std::string>::const_iterator end = jsonIOConfigFiles.end();
+            std::vector<std::string>::const_iterator iter;
+            for (iter = jsonIOConfigFiles.begin();
+                 iter != end;
+                 ++iter) {
+                if (!cmnPath::Exists(*iter)) {
+                    NODELET_ERROR_STREAM("dvrk console nodelet: file not found " << *iter);
+                    continue;
+                }
+                mConsoleROS->Configure(*iter);
+            }
+            mConsoleROS->Connect();
+
+            mConsoleROS->Profiler().Begin("CreateAllAndWait");
+            componentManager->CreateAllAndWait(2.0 * cmn_s);
+            mConsoleROS->Profiler().Begin("StartAllAndWait");
+            componentManager->StartAllAndWait(2.0 * cmn_s);
+            mConsoleROS->Profiler().End();
+            if (startupProfile) {
+                std::stringstream report;
+                mConsoleROS->Profiler().Report(report);
+                NODELET_INFO_STREAM(report.str());
+            }
+        }
+
+        mtsIntuitiveResearchKitConsole * mConsole;
+        dvrk::console * mConsoleROS;
+    };
+}
+
+PLUGINLIB_EXPORT_CLASS(dvrk::console_nodelet, nodelet::Nodelet)
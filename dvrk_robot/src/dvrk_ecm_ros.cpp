@@ -203,7 +203,7 @@ int main(int argc, char ** argv)
     tabWidget->show();
 
     // ros wrapper
-    mtsROSBridge robotBridge("RobotBridge", rosPeriod, true);
+    dvrk::bridge robotBridge("RobotBridge", rosPeriod, true, true);
 
     // populate interfaces
     const dvrk_topics_version::version version = dvrk_topics_version::v1_3_0;
@@ -351,7 +351,7 @@ int main(int argc, char ** argv)
     ///////////////////////  ROS Bridge   ////////////////////////////////////////////
 
     // Starting ROS-Bridge Here
-    mtsROSBridge rosBridge("RobotBridge", 20 * cmn_ms, true, false);
+    dvrk::bridge rosBridge("RobotBridge", 20 * cmn_ms, true, false);
 
     // populate interfaces
     const dvrk_topics_version::version version = dvrk_topics_version::v1_3_0;
@@ -364,10 +364,10 @@ int main(int argc, char ** argv)
     componentManager->AddComponent(&rosBridge);
 
     // connect all ros bridge interfaces
-    componentManager->Connect(rosBridge.GetName(), "MTML", "MTML", "Robot");
-    componentManager->Connect(rosBridge.GetName(), "MTMR", "MTMR", "Robot");
-    componentManager->Connect(rosBridge.GetName(), "PSM1", "PSM1", "Robot");
-    componentManager->Connect(rosBridge.GetName(), "PSM2", "PSM2", "Robot");
+    dvrk::connect_bridge_mtm(rosBridge.GetName(), "MTML", "MTML", "Robot");
+    dvrk::connect_bridge_mtm(rosBridge.GetName(), "MTMR", "MTMR", "Robot");
+    dvrk::connect_bridge_psm(rosBridge.GetName(), "PSM1", "PSM1", "Robot");
+    dvrk::connect_bridge_psm(rosBridge.GetName(), "PSM2", "PSM2", "Robot");
     dvrk::connect_bridge_footpedals(rosBridge.GetName(), "io");
 
     ///////////////////////////////////////////////////////////////////
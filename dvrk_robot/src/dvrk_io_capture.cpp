@@ -0,0 +1,122 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-22
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <dvrk_utilities/dvrk_io_capture.h>
+
+dvrk::io_capture_publisher::io_capture_publisher(const std::string & topic_name,
+                                                 const size_t samples_per_chunk,
+                                                 const size_t buffer_size):
+    publisher_base(topic_name, dvrk_topics_rate::fast, 10),
+    mSamplesPerChunk(std::max(samples_per_chunk, static_cast<size_t>(1))),
+    // one slot is always left empty to tell a full buffer from an empty one
+    mBuffer(std::max(buffer_size, mSamplesPerChunk) + 1),
+    mHead(0),
+    mTail(0),
+    mActive(false),
+    mDropped(0)
+{
+}
+
+void dvrk::io_capture_publisher::Advertise(ros::NodeHandle & node_handle)
+{
+    mPublisher = node_handle.advertise<dvrk_robot::IOSamples>(mTopicName, mQueueSize);
+}
+
+bool dvrk::io_capture_publisher::AddFunctions(mtsInterfaceRequired * interface_required,
+                                              mtsInterfaceRequired * run_interface_required)
+{
+    if (!interface_required->AddFunction("GetPosition", IO.GetPosition)
+        || !interface_required->AddFunction("GetPositionActuator", IO.GetPositionActuator)
+        || !interface_required->AddFunction("GetAnalogInputPosSI", IO.GetAnalogInputPosSI)) {
+        return false;
+    }
+    return (run_interface_required->AddEventHandlerVoid(&io_capture_publisher::RunEventHandler, this,
+                                                        "RunEvent", MTS_EVENT_NOT_QUEUED) != 0);
+}
+
+void dvrk::io_capture_publisher::RunEventHandler(void)
+{
+    if (!mActive.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const size_t head = mHead.load(std::memory_order_relaxed);
+    const size_t next = (head + 1) % mBuffer.size();
+    if (next == mTail.load(std::memory_order_acquire)) {
+        ++mDropped;
+        return;
+    }
+    Sample & sample = mBuffer[head];
+    IO.GetPositionActuator(mActuatorPosition);
+    IO.GetPosition(sample.JointPosition);
+    IO.GetAnalogInputPosSI(sample.PotentiometerPosition);
+    sample.Timestamp = mActuatorPosition.Timestamp();
+    sample.ActuatorPosition.ForceAssign(mActuatorPosition.Position());
+    mHead.store(next, std::memory_order_release);
+}
+
+bool dvrk::io_capture_publisher::Execute(void)
+{
+    const bool active = !mLazy || (mPublisher.getNumSubscribers() > 0);
+    mActive.store(active, std::memory_order_relaxed);
+    const size_t head = mHead.load(std::memory_order_acquire);
+    size_t tail = mTail.load(std::memory_order_relaxed);
+    if (!active) {
+        // discard whatever was captured before the last subscriber left
+        mTail.store(head, std::memory_order_release);
+        return true;
+    }
+
+    const size_t size = mBuffer.size();
+    size_t available = (head + size - tail) % size;
+    while (available >= mSamplesPerChunk) {
+        const Sample & first = mBuffer[tail];
+        const size_t joints = first.JointPosition.size();
+        const size_t actuators = first.ActuatorPosition.size();
+        dvrk_robot::IOSamples::Ptr rosData(new dvrk_robot::IOSamples);
+        rosData->header.stamp = ros::Time::now();
+        rosData->dropped = mDropped.exchange(0);
+        rosData->number_of_joints = joints;
+        rosData->number_of_actuators = actuators;
+        rosData->timestamps.reserve(mSamplesPerChunk);
+        rosData->joint_position.reserve(mSamplesPerChunk * joints);
+        rosData->actuator_position.reserve(mSamplesPerChunk * actuators);
+        rosData->potentiometer_position.reserve(mSamplesPerChunk * actuators);
+        double lastTimestamp = 0.0;
+        for (size_t index = 0; index < mSamplesPerChunk; ++index) {
+            const Sample & sample = mBuffer[tail];
+            rosData->timestamps.push_back(sample.Timestamp);
+            rosData->joint_position.insert(rosData->joint_position.end(),
+                                           sample.JointPosition.begin(),
+                                           sample.JointPosition.end());
+            rosData->actuator_position.insert(rosData->actuator_position.end(),
+                                              sample.ActuatorPosition.begin(),
+                                              sample.ActuatorPosition.end());
+            rosData->potentiometer_position.insert(rosData->potentiometer_position.end(),
+                                                   sample.PotentiometerPosition.begin(),
+                                                   sample.PotentiometerPosition.end());
+            lastTimestamp = sample.Timestamp;
+            tail = (tail + 1) % size;
+        }
+        // release the slots before publishing so the IO thread can reuse them
+        mTail.store(tail, std::memory_order_release);
+        mPublisher.publish(rosData);
+        RecordLatency(lastTimestamp);
+        available -= mSamplesPerChunk;
+    }
+    return true;
+}
@@ -0,0 +1,72 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-31
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisst_ros_bridge/mtsCISSTToROS.h>
+
+#include <dvrk_utilities/dvrk_jacobian_service.h>
+
+dvrk::jacobian_service::jacobian_service(const std::string & service_name):
+    mServiceName(service_name)
+{
+}
+
+bool dvrk::jacobian_service::AddFunctions(mtsInterfaceRequired * interface_required)
+{
+    return interface_required->AddFunction("GetJacobianBody", Arm.GetJacobianBody)
+        && interface_required->AddFunction("GetJacobianSpatial", Arm.GetJacobianSpatial)
+        && interface_required->AddFunction("ComputeJacobianBody", Arm.ComputeJacobianBody, MTS_OPTIONAL)
+        && interface_required->AddFunction("ComputeJacobianSpatial", Arm.ComputeJacobianSpatial, MTS_OPTIONAL);
+}
+
+void dvrk::jacobian_service::Advertise(ros::NodeHandle & node_handle)
+{
+    mServer = node_handle.advertiseService(mServiceName, &jacobian_service::Callback, this);
+}
+
+bool dvrk::jacobian_service::Callback(dvrk_robot::QueryJacobian::Request & request,
+                                      dvrk_robot::QueryJacobian::Response & response)
+{
+    response.success = false;
+    if (request.position.empty()) {
+        if (!Arm.GetJacobianBody(mBodyJacobian)
+            || !Arm.GetJacobianSpatial(mSpatialJacobian)) {
+            response.message = "failed to read the arm's Jacobians";
+            return true;
+        }
+    } else {
+        if (!Arm.ComputeJacobianBody.IsValid()
+            || !Arm.ComputeJacobianSpatial.IsValid()) {
+            response.message = "arm doesn't support Jacobians for given joint positions";
+            return true;
+        }
+        mPosition.SetSize(request.position.size());
+        std::copy(request.position.begin(), request.position.end(), mPosition.begin());
+        if (!Arm.ComputeJacobianBody(mPosition, mBodyJacobian)
+            || !Arm.ComputeJacobianSpatial(mPosition, mSpatialJacobian)) {
+            response.message = "failed to compute the Jacobians, check the number of joints";
+            return true;
+        }
+    }
+    if (!mtsCISSTToROS(mBodyJacobian, response.body, mServiceName)
+        || !mtsCISSTToROS(mSpatialJacobian, response.spatial, mServiceName)) {
+        response.message = "failed to convert the Jacobians";
+        return true;
+    }
+    response.success = true;
+    return true;
+}
@@ -0,0 +1,86 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-20
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <dvrk_utilities/dvrk_latency_histogram.h>
+
+// smallest latency with its own bin
+const double minimumLatency = 1.0e-6;
+
+dvrk::latency_histogram::latency_histogram(void):
+    mBins(BinsPerOctave * NumberOfOctaves + 1, 0),
+    mCount(0),
+    mMax(0.0)
+{
+}
+
+void dvrk::latency_histogram::Add(const double & latency_in_seconds)
+{
+    if (latency_in_seconds < 0.0) {
+        return;
+    }
+    size_t bin = 0;
+    if (latency_in_seconds > minimumLatency) {
+        bin = static_cast<size_t>(std::log2(latency_in_seconds / minimumLatency) * BinsPerOctave) + 1;
+        bin = std::min(bin, mBins.size() - 1);
+    }
+    ++mBins[bin];
+    ++mCount;
+    mMax = std::max(mMax, latency_in_seconds);
+}
+
+void dvrk::latency_histogram::Merge(const latency_histogram & other)
+{
+    for (size_t bin = 0; bin < mBins.size(); ++bin) {
+        mBins[bin] += other.mBins[bin];
+    }
+    mCount += other.mCount;
+    mMax = std::max(mMax, other.mMax);
+}
+
+void dvrk::latency_histogram::Reset(void)
+{
+    std::fill(mBins.begin(), mBins.end(), 0);
+    mCount = 0;
+    mMax = 0.0;
+}
+
+double dvrk::latency_histogram::Percentile(const double & percentile) const
+{
+    if (mCount == 0) {
+        return 0.0;
+    }
+    const size_t target = std::max(static_cast<size_t>(1),
+                                   static_cast<size_t>(std::ceil(percentile * mCount)));
+    size_t sum = 0;
+    for (size_t bin = 0; bin < mBins.size(); ++bin) {
+        sum += mBins[bin];
+        if (sum >= target) {
+            // last bin has no upper bound
+            return std::min(UpperBound(bin), mMax);
+        }
+    }
+    return mMax;
+}
+
+double dvrk::latency_histogram::UpperBound(const size_t bin)
+{
+    return minimumLatency * std::pow(2.0, static_cast<double>(bin) / BinsPerOctave);
+}
@@ -0,0 +1,133 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-24
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// Reader side of the shared memory state, no dependency on cisst nor
+// ROS so the library can be loaded by any local client.
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <string.h>
+
+#include <dvrk_utilities/dvrk_shared_state.h>
+
+struct dvrk_shared_state_reader {
+    void * Memory;
+    size_t Size;
+    const dvrk_shared_state_header * Header;
+    const dvrk_shared_state_slot * Slots;
+};
+
+namespace {
+    // maximum number of attempts to get a consistent snapshot
+    const int maximum_attempts = 10000;
+}
+
+dvrk_shared_state_reader * dvrk_shared_state_open(const char * segment_name)
+{
+    const int fileDescriptor = shm_open(segment_name, O_RDONLY, 0);
+    if (fileDescriptor < 0) {
+        return 0;
+    }
+    struct stat status;
+    if ((fstat(fileDescriptor, &status) != 0)
+        || (static_cast<size_t>(status.st_size) < sizeof(dvrk_shared_state_header))) {
+        close(fileDescriptor);
+        return 0;
+    }
+    void * memory = mmap(0, status.st_size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (memory == MAP_FAILED) {
+        return 0;
+    }
+    const dvrk_shared_state_header * header = static_cast<const dvrk_shared_state_header *>(memory);
+    const size_t numberOfArms = __atomic_load_n(&(header->NumberOfArms), __ATOMIC_ACQUIRE);
+    if ((strncmp(header->Magic, "DVRKSHM", sizeof(header->Magic)) != 0)
+        || (header->Version != DVRK_SHARED_STATE_VERSION)
+        || (header->SlotSize != sizeof(dvrk_shared_state_slot))
+        || (static_cast<size_t>(status.st_size) < sizeof(dvrk_shared_state_slot) * (numberOfArms + 1))) {
+        munmap(memory, status.st_size);
+        return 0;
+    }
+    dvrk_shared_state_reader * reader = new dvrk_shared_state_reader;
+    reader->Memory = memory;
+    reader->Size = status.st_size;
+    reader->Header = header;
+    // first slot is used for the header to keep slots aligned
+    reader->Slots = static_cast<const dvrk_shared_state_slot *>(memory) + 1;
+    return reader;
+}
+
+void dvrk_shared_state_close(dvrk_shared_state_reader * reader)
+{
+    if (!reader) {
+        return;
+    }
+    munmap(reader->Memory, reader->Size);
+    delete reader;
+}
+
+int dvrk_shared_state_number_of_arms(const dvrk_shared_state_reader * reader)
+{
+    return __atomic_load_n(&(reader->Header->NumberOfArms), __ATOMIC_ACQUIRE);
+}
+
+const char * dvrk_shared_state_arm_name(const dvrk_shared_state_reader * reader,
+                                        const int index)
+{
+    if ((index < 0) || (index >= dvrk_shared_state_number_of_arms(reader))) {
+        return 0;
+    }
+    return reader->Slots[index].Name;
+}
+
+int dvrk_shared_state_find_arm(const dvrk_shared_state_reader * reader,
+                               const char * arm_name)
+{
+    const int numberOfArms = dvrk_shared_state_number_of_arms(reader);
+    for (int index = 0; index < numberOfArms; ++index) {
+        if (strncmp(reader->Slots[index].Name, arm_name, sizeof(reader->Slots[index].Name)) == 0) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+int dvrk_shared_state_read(const dvrk_shared_state_reader * reader,
+                           const int index,
+                           dvrk_arm_state * state)
+{
+    if ((index < 0) || (index >= dvrk_shared_state_number_of_arms(reader))) {
+        return -1;
+    }
+    const dvrk_shared_state_slot & slot = reader->Slots[index];
+    for (int attempt = 0; attempt < maximum_attempts; ++attempt) {
+        const uint32_t before = __atomic_load_n(&(slot.Sequence), __ATOMIC_ACQUIRE);
+        if (before & 1) {
+            // writer in progress
+            continue;
+        }
+        memcpy(state, &(slot.State), sizeof(dvrk_arm_state));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&(slot.Sequence), __ATOMIC_RELAXED) == before) {
+            return 0;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,169 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-24
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+
+#include <dvrk_utilities/dvrk_shared_state_writer.h>
+
+dvrk::shared_state_writer::shared_state_writer(const std::string & component_name,
+                                               const std::string & segment_name):
+    mtsComponent(component_name),
+    mSegmentName(segment_name),
+    mSize(0),
+    mMemory(0),
+    mExporting(false),
+    mWriters(0)
+{
+}
+
+dvrk::shared_state_writer::~shared_state_writer()
+{
+    Close();
+    const std::list<arm_slot *>::iterator end = mArms.end();
+    std::list<arm_slot *>::iterator arm;
+    for (arm = mArms.begin();
+         arm != end;
+         ++arm) {
+        delete *arm;
+    }
+}
+
+bool dvrk::shared_state_writer::AddArm(const std::string & arm_name)
+{
+    if (mArms.size() >= DVRK_SHARED_STATE_MAXIMUM_ARMS) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddArm: can't add \"" << arm_name
+                                 << "\", maximum number of arms reached" << std::endl;
+        return false;
+    }
+    if (arm_name.size() >= sizeof(dvrk_shared_state_slot::Name)) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddArm: name \"" << arm_name << "\" is too long" << std::endl;
+        return false;
+    }
+    mtsInterfaceRequired * interfaceRequired = AddInterfaceRequired(arm_name);
+    mtsInterfaceRequired * runInterfaceRequired = AddInterfaceRequired(arm_name + "-run");
+    if (!interfaceRequired || !runInterfaceRequired) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddArm: failed to create required interfaces for \""
+                                 << arm_name << "\"" << std::endl;
+        return false;
+    }
+    arm_slot * arm = new arm_slot(this);
+    arm->Name = arm_name;
+    if (!arm->Sampler.AddFunctions(interfaceRequired)
+        || !runInterfaceRequired->AddEventHandlerVoid(&arm_slot::RunEventHandler, arm,
+                                                      "RunEvent", MTS_EVENT_NOT_QUEUED)) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddArm: failed to add functions for \""
+                                 << arm_name << "\"" << std::endl;
+        delete arm;
+        return false;
+    }
+    mArms.push_back(arm);
+    return true;
+}
+
+void dvrk::shared_state_writer::Startup(void)
+{
+    Open();
+}
+
+void dvrk::shared_state_writer::Cleanup(void)
+{
+    Close();
+}
+
+bool dvrk::shared_state_writer::Open(void)
+{
+    // first slot is used for the header to keep slots aligned
+    mSize = (mArms.size() + 1) * sizeof(dvrk_shared_state_slot);
+    const int fileDescriptor = shm_open(mSegmentName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fileDescriptor < 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "Open: failed to create shared memory \"" << mSegmentName
+                                 << "\": " << strerror(errno) << std::endl;
+        return false;
+    }
+    if (ftruncate(fileDescriptor, mSize) != 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "Open: failed to resize shared memory \"" << mSegmentName
+                                 << "\": " << strerror(errno) << std::endl;
+        close(fileDescriptor);
+        shm_unlink(mSegmentName.c_str());
+        return false;
+    }
+    mMemory = mmap(0, mSize, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (mMemory == MAP_FAILED) {
+        CMN_LOG_CLASS_INIT_ERROR << "Open: failed to map shared memory \"" << mSegmentName
+                                 << "\": " << strerror(errno) << std::endl;
+        mMemory = 0;
+        shm_unlink(mSegmentName.c_str());
+        return false;
+    }
+    memset(mMemory, 0, mSize);
+    dvrk_shared_state_header * header = static_cast<dvrk_shared_state_header *>(mMemory);
+    strncpy(header->Magic, "DVRKSHM", sizeof(header->Magic));
+    header->Version = DVRK_SHARED_STATE_VERSION;
+    header->SlotSize = sizeof(dvrk_shared_state_slot);
+    dvrk_shared_state_slot * slot = static_cast<dvrk_shared_state_slot *>(mMemory) + 1;
+    const std::list<arm_slot *>::iterator end = mArms.end();
+    std::list<arm_slot *>::iterator arm;
+    for (arm = mArms.begin();
+         arm != end;
+         ++arm, ++slot) {
+        strncpy(slot->Name, (*arm)->Name.c_str(), sizeof(slot->Name) - 1);
+        (*arm)->Slot = slot;
+    }
+    // readers only look at the slots once the number of arms is set
+    __atomic_store_n(&(header->NumberOfArms), mArms.size(), __ATOMIC_RELEASE);
+    mExporting = true;
+    return true;
+}
+
+void dvrk::shared_state_writer::Close(void)
+{
+    if (!mMemory) {
+        return;
+    }
+    // stop exporting and wait for the states in progress, if any
+    mExporting = false;
+    while (mWriters > 0) {
+        sched_yield();
+    }
+    munmap(mMemory, mSize);
+    mMemory = 0;
+    shm_unlink(mSegmentName.c_str());
+}
+
+void dvrk::shared_state_writer::arm_slot::RunEventHandler(void)
+{
+    ++(Writer->mWriters);
+    if (Writer->mExporting) {
+        // read from the arm first to keep the write section short
+        Sampler.Sample(State);
+        // seqlock, sequence is odd while the state is updated
+        const uint32_t sequence = Slot->Sequence;
+        __atomic_store_n(&(Slot->Sequence), sequence + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        memcpy(&(Slot->State), &State, sizeof(dvrk_arm_state));
+        __atomic_store_n(&(Slot->Sequence), sequence + 2, __ATOMIC_RELEASE);
+    }
+    --(Writer->mWriters);
+}
@@ -0,0 +1,68 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-21
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <iomanip>
+
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <dvrk_utilities/dvrk_startup_profiler.h>
+
+dvrk::startup_profiler::startup_profiler(void):
+    mStart(0.0),
+    mRunning(false)
+{
+}
+
+void dvrk::startup_profiler::Begin(const std::string & step)
+{
+    End();
+    mCurrent.Name = step;
+    mStart = osaGetTime();
+    mRunning = true;
+}
+
+void dvrk::startup_profiler::End(void)
+{
+    if (!mRunning) {
+        return;
+    }
+    mCurrent.Duration = osaGetTime() - mStart;
+    mSteps.push_back(mCurrent);
+    mRunning = false;
+}
+
+void dvrk::startup_profiler::Report(std::ostream & output) const
+{
+    // don't leave the caller's stream in fixed notation
+    const std::ios_base::fmtflags flags = output.flags();
+    const std::streamsize precision = output.precision();
+    double total = 0.0;
+    output << "Startup profile (ms):" << std::endl;
+    const std::list<Step>::const_iterator end = mSteps.end();
+    std::list<Step>::const_iterator iter;
+    for (iter = mSteps.begin();
+         iter != end;
+         ++iter) {
+        output << std::setw(10) << std::fixed << std::setprecision(2)
+               << iter->Duration * 1000.0 << "  " << iter->Name << std::endl;
+        total += iter->Duration;
+    }
+    output << std::setw(10) << std::fixed << std::setprecision(2)
+           << total * 1000.0 << "  total" << std::endl;
+    output.flags(flags);
+    output.precision(precision);
+}
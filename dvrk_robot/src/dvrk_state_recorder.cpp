@@ -0,0 +1,169 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-23
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <algorithm>
+
+#include <cisstMultiTask/mtsInterfaceRequired.h>
+
+#include <dvrk_utilities/dvrk_state_recorder.h>
+
+dvrk::state_recorder::state_recorder(const std::string & component_name,
+                                     const std::string & file_name,
+                                     const size_t capacity,
+                                     const double & period_in_seconds):
+    mtsComponent(component_name),
+    mFileName(file_name),
+    mCapacity(std::max(capacity, static_cast<size_t>(1))),
+    mPeriod(period_in_seconds),
+    mFileDescriptor(-1),
+    mFileSize(0),
+    mMemory(0),
+    mHeader(0),
+    mRecords(0),
+    mRecording(false),
+    mWriting(false)
+{
+    mtsInterfaceRequired * interfaceRequired = AddInterfaceRequired("Arm");
+    if (interfaceRequired) {
+        mSampler.AddFunctions(interfaceRequired);
+    }
+    interfaceRequired = AddInterfaceRequired("Run");
+    if (interfaceRequired) {
+        interfaceRequired->AddEventHandlerVoid(&state_recorder::RunEventHandler, this,
+                                               "RunEvent", MTS_EVENT_NOT_QUEUED);
+    }
+}
+
+dvrk::state_recorder::~state_recorder()
+{
+    Close();
+}
+
+void dvrk::state_recorder::Startup(void)
+{
+    Open();
+}
+
+void dvrk::state_recorder::Cleanup(void)
+{
+    Close();
+}
+
+bool dvrk::state_recorder::Open(void)
+{
+    mFileSize = sizeof(state_record_file_header) + mCapacity * sizeof(state_record);
+    mFileDescriptor = open(mFileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (mFileDescriptor < 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "Open: failed to open \"" << mFileName
+                                 << "\": " << strerror(errno) << std::endl;
+        return false;
+    }
+    // allocate all the blocks now so the arm thread never waits for
+    // the file system while recording
+    const int result = posix_fallocate(mFileDescriptor, 0, mFileSize);
+    if (result != 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "Open: failed to allocate " << mFileSize
+                                 << " bytes for \"" << mFileName << "\": "
+                                 << strerror(result) << std::endl;
+        close(mFileDescriptor);
+        mFileDescriptor = -1;
+        return false;
+    }
+    // MAP_POPULATE pre-faults the pages, also avoids page faults in
+    // the arm thread
+    mMemory = mmap(0, mFileSize, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, mFileDescriptor, 0);
+    if (mMemory == MAP_FAILED) {
+        CMN_LOG_CLASS_INIT_ERROR << "Open: failed to map \"" << mFileName
+                                 << "\": " << strerror(errno) << std::endl;
+        mMemory = 0;
+        close(mFileDescriptor);
+        mFileDescriptor = -1;
+        return false;
+    }
+    mHeader = static_cast<state_record_file_header *>(mMemory);
+    mRecords = reinterpret_cast<state_record *>(mHeader + 1);
+    memset(mHeader, 0, sizeof(state_record_file_header));
+    strncpy(mHeader->Magic, "DVRKREC", sizeof(mHeader->Magic));
+    mHeader->Version = state_record_version;
+    mHeader->RecordSize = sizeof(state_record);
+    mHeader->Capacity = mCapacity;
+    mHeader->Period = mPeriod;
+    strncpy(mHeader->Name, GetName().c_str(), sizeof(mHeader->Name) - 1);
+    mRecording = true;
+    return true;
+}
+
+void dvrk::state_recorder::Close(void)
+{
+    if (!mMemory) {
+        return;
+    }
+    // stop recording and wait for the record in progress, if any
+    mRecording = false;
+    while (mWriting) {
+        sched_yield();
+    }
+    state_record_file_header * header = mHeader;
+    mHeader = 0;
+    const size_t used = sizeof(state_record_file_header)
+        + header->NumberOfRecords * sizeof(state_record);
+    if (header->NumberOfDropped > 0) {
+        CMN_LOG_CLASS_RUN_WARNING << "Close: " << header->NumberOfDropped
+                                  << " records dropped, file \"" << mFileName
+                                  << "\" was full" << std::endl;
+    }
+    msync(mMemory, mFileSize, MS_SYNC);
+    munmap(mMemory, mFileSize);
+    mMemory = 0;
+    mRecords = 0;
+    if (ftruncate(mFileDescriptor, used) != 0) {
+        CMN_LOG_CLASS_RUN_WARNING << "Close: failed to truncate \"" << mFileName
+                                  << "\": " << strerror(errno) << std::endl;
+    }
+    close(mFileDescriptor);
+    mFileDescriptor = -1;
+}
+
+void dvrk::state_recorder::RunEventHandler(void)
+{
+    mWriting = true;
+    if (!mRecording) {
+        mWriting = false;
+        return;
+    }
+    state_record_file_header * header = mHeader;
+    if (header->NumberOfRecords >= header->Capacity) {
+        ++(header->NumberOfDropped);
+        mWriting = false;
+        return;
+    }
+
+    // write directly in the mapped file
+    mSampler.Sample(mRecords[header->NumberOfRecords]);
+
+    // publish the record for readers of the file once it's complete
+    __atomic_store_n(&(header->NumberOfRecords), header->NumberOfRecords + 1, __ATOMIC_RELEASE);
+    mWriting = false;
+}
@@ -0,0 +1,322 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-23
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+// Converts files created by dvrk::state_recorder to CSV or replays
+// them on ROS topics (measured_js, setpoint_js and measured_cp) using
+// the recorded timestamps.
+
+// system
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <string.h>
+
+// cisst/saw
+#include <cisstCommon/cmnCommandLineOptions.h>
+
+#include <ros/ros.h>
+#include <sensor_msgs/JointState.h>
+#include <geometry_msgs/PoseStamped.h>
+#include <dvrk_utilities/dvrk_state_recorder.h>
+
+namespace dvrk {
+
+    /*! Read only view of a state recorder file. */
+    class state_record_file
+    {
+    public:
+        state_record_file(void):
+            mMemory(MAP_FAILED),
+            mSize(0),
+            mHeader(0),
+            mRecords(0)
+        {}
+
+        ~state_record_file() {
+            if (mMemory != MAP_FAILED) {
+                munmap(mMemory, mSize);
+            }
+        }
+
+        bool Open(const std::string & file_name) {
+            const int fileDescriptor = open(file_name.c_str(), O_RDONLY);
+            if (fileDescriptor < 0) {
+                std::cerr << "Error: failed to open \"" << file_name << "\": " << strerror(errno) << std::endl;
+                return false;
+            }
+            struct stat status;
+            if ((fstat(fileDescriptor, &status) != 0)
+                || (static_cast<size_t>(status.st_size) < sizeof(state_record_file_header))) {
+                std::cerr << "Error: \"" << file_name << "\" is too small for a state recorder file" << std::endl;
+                close(fileDescriptor);
+                return false;
+            }
+            mSize = status.st_size;
+            mMemory = mmap(0, mSize, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+            close(fileDescriptor);
+            if (mMemory == MAP_FAILED) {
+                std::cerr << "Error: failed to map \"" << file_name << "\": " << strerror(errno) << std::endl;
+                return false;
+            }
+            mHeader = static_cast<const state_record_file_header *>(mMemory);
+            if ((strncmp(mHeader->Magic, "DVRKREC", sizeof(mHeader->Magic)) != 0)
+                || (mHeader->Version != state_record_version)
+                || (mHeader->RecordSize != sizeof(state_record))) {
+                std::cerr << "Error: \"" << file_name << "\" is not a state recorder file or uses a different version" << std::endl;
+                return false;
+            }
+            mRecords = reinterpret_cast<const state_record *>(mHeader + 1);
+            return true;
+        }
+
+        /*! Number of complete records, the file might still be
+          written by a recorder. */
+        size_t NumberOfRecords(void) const {
+            const size_t inFile = (mSize - sizeof(state_record_file_header)) / sizeof(state_record);
+            return std::min(static_cast<size_t>(mHeader->NumberOfRecords), inFile);
+        }
+
+        const state_record_file_header & Header(void) const {
+            return *mHeader;
+        }
+
+        const state_record & Record(const size_t index) const {
+            return mRecords[index];
+        }
+
+    protected:
+        void * mMemory;
+        size_t mSize;
+        const state_record_file_header * mHeader;
+        const state_record * mRecords;
+    };
+
+    void write_csv_header(std::ostream & output, const size_t number_of_joints)
+    {
+        output << "timestamp,valid";
+        const char * jointFields[] = {"measured_position", "measured_velocity", "measured_effort",
+                                      "setpoint_position", "setpoint_effort"};
+        for (size_t field = 0; field < 5; ++field) {
+            for (size_t joint = 0; joint < number_of_joints; ++joint) {
+                output << ',' << jointFields[field] << '_' << joint;
+            }
+        }
+        const char * frameFields[] = {"measured_cp", "setpoint_cp"};
+        for (size_t field = 0; field < 2; ++field) {
+            output << ',' << frameFields[field] << "_x"
+                   << ',' << frameFields[field] << "_y"
+                   << ',' << frameFields[field] << "_z";
+            for (size_t element = 0; element < 9; ++element) {
+                output << ',' << frameFields[field] << "_r" << element / 3 << element % 3;
+            }
+        }
+        output << ",body_measured_cf_fx,body_measured_cf_fy,body_measured_cf_fz"
+               << ",body_measured_cf_tx,body_measured_cf_ty,body_measured_cf_tz"
+               << std::endl;
+    }
+
+    void write_csv_record(std::ostream & output, const state_record & record,
+                          const size_t number_of_joints)
+    {
+        output << record.Timestamp << ',' << record.Valid;
+        const double * jointFields[] = {record.MeasuredPosition, record.MeasuredVelocity, record.MeasuredEffort,
+                                        record.SetpointPosition, record.SetpointEffort};
+        for (size_t field = 0; field < 5; ++field) {
+            for (size_t joint = 0; joint < number_of_joints; ++joint) {
+                output << ',' << jointFields[field][joint];
+            }
+        }
+        for (size_t element = 0; element < 12; ++element) {
+            output << ',' << record.MeasuredCP[element];
+        }
+        for (size_t element = 0; element < 12; ++element) {
+            output << ',' << record.SetpointCP[element];
+        }
+        for (size_t element = 0; element < 6; ++element) {
+            output << ',' << record.BodyMeasuredCF[element];
+        }
+        output << '\n';
+    }
+
+    /*! Velocity can be 0 (null) if not recorded. */
+    void record_to_joint_state(const double * position, const double * velocity, const double * effort,
+                               const size_t number_of_joints, sensor_msgs::JointState & joint_state)
+    {
+        joint_state.position.assign(position, position + number_of_joints);
+        if (velocity) {
+            joint_state.velocity.assign(velocity, velocity + number_of_joints);
+        }
+        joint_state.effort.assign(effort, effort + number_of_joints);
+    }
+
+    void record_to_pose(const double * frame, geometry_msgs::Pose & pose)
+    {
+        pose.position.x = frame[0];
+        pose.position.y = frame[1];
+        pose.position.z = frame[2];
+        // rotation matrix to quaternion, r is row major
+        const double * r = frame + 3;
+        const double trace = r[0] + r[4] + r[8];
+        if (trace > 0.0) {
+            const double s = 0.5 / std::sqrt(trace + 1.0);
+            pose.orientation.w = 0.25 / s;
+            pose.orientation.x = (r[7] - r[5]) * s;
+            pose.orientation.y = (r[2] - r[6]) * s;
+            pose.orientation.z = (r[3] - r[1]) * s;
+        } else if ((r[0] > r[4]) && (r[0] > r[8])) {
+            const double s = 2.0 * std::sqrt(1.0 + r[0] - r[4] - r[8]);
+            pose.orientation.w = (r[7] - r[5]) / s;
+            pose.orientation.x = 0.25 * s;
+            pose.orientation.y = (r[1] + r[3]) / s;
+            pose.orientation.z = (r[2] + r[6]) / s;
+        } else if (r[4] > r[8]) {
+            const double s = 2.0 * std::sqrt(1.0 + r[4] - r[0] - r[8]);
+            pose.orientation.w = (r[2] - r[6]) / s;
+            pose.orientation.x = (r[1] + r[3]) / s;
+            pose.orientation.y = 0.25 * s;
+            pose.orientation.z = (r[5] + r[7]) / s;
+        } else {
+            const double s = 2.0 * std::sqrt(1.0 + r[8] - r[0] - r[4]);
+            pose.orientation.w = (r[3] - r[1]) / s;
+            pose.orientation.x = (r[2] + r[6]) / s;
+            pose.orientation.y = (r[5] + r[7]) / s;
+            pose.orientation.z = 0.25 * s;
+        }
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    // parse options
+    cmnCommandLineOptions options;
+    std::string fileName;
+    std::string outputName;
+    std::string rosNamespace;
+    double speed = 1.0;
+
+    options.AddOptionOneValue("f", "file",
+                              "file created by the state recorder",
+                              cmnCommandLineOptions::REQUIRED_OPTION, &fileName);
+    options.AddOptionOneValue("o", "output",
+                              "CSV file to create (default is standard output)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &outputName);
+    options.AddOptionOneValue("r", "replay",
+                              "replay the records on ROS topics in the given namespace (e.g. \"dvrk/PSM1\") instead of converting to CSV",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &rosNamespace);
+    options.AddOptionOneValue("s", "speed",
+                              "replay speed factor (default 1.0)",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &speed);
+
+    std::string errorMessage;
+    if (!options.Parse(argc, argv, errorMessage)) {
+        std::cerr << "Error: " << errorMessage << std::endl;
+        options.PrintUsage(std::cerr);
+        return -1;
+    }
+
+    dvrk::state_record_file file;
+    if (!file.Open(fileName)) {
+        return -1;
+    }
+    const size_t numberOfRecords = file.NumberOfRecords();
+    std::cerr << "File \"" << fileName << "\" for " << file.Header().Name
+              << ": " << numberOfRecords << " records, " << file.Header().NumberOfDropped
+              << " dropped, period " << file.Header().Period << "s" << std::endl;
+    if (numberOfRecords == 0) {
+        return 0;
+    }
+    // number of joints is read from the file, used as array bound
+    const size_t numberOfJoints = file.Record(0).NumberOfJoints;
+    if (numberOfJoints > dvrk::state_record_maximum_joints) {
+        std::cerr << "Error: invalid number of joints (" << numberOfJoints << ") in \""
+                  << fileName << "\", maximum is " << dvrk::state_record_maximum_joints << std::endl;
+        return -1;
+    }
+
+    // convert to CSV
+    if (!options.IsSet("replay")) {
+        std::ofstream outputFile;
+        if (!outputName.empty()) {
+            outputFile.open(outputName.c_str());
+            if (!outputFile.is_open()) {
+                std::cerr << "Error: failed to create \"" << outputName << "\"" << std::endl;
+                return -1;
+            }
+        }
+        std::ostream & output = outputName.empty() ? std::cout : outputFile;
+        output << std::setprecision(17);
+        dvrk::write_csv_header(output, numberOfJoints);
+        for (size_t index = 0; index < numberOfRecords; ++index) {
+            dvrk::write_csv_record(output, file.Record(index), numberOfJoints);
+        }
+        return 0;
+    }
+
+    // replay using the recorded timestamps
+    if (speed <= 0.0) {
+        std::cerr << "Error: replay speed must be greater than 0" << std::endl;
+        return -1;
+    }
+    ros::init(argc, argv, "dvrk_state_recorder_convert", ros::init_options::AnonymousName);
+    ros::NodeHandle nodeHandle;
+    if (!rosNamespace.empty() && (rosNamespace[rosNamespace.size() - 1] != '/')) {
+        rosNamespace.append("/");
+    }
+    ros::Publisher measuredJS = nodeHandle.advertise<sensor_msgs::JointState>(rosNamespace + "measured_js", 10);
+    ros::Publisher setpointJS = nodeHandle.advertise<sensor_msgs::JointState>(rosNamespace + "setpoint_js", 10);
+    ros::Publisher measuredCP = nodeHandle.advertise<geometry_msgs::PoseStamped>(rosNamespace + "measured_cp", 10);
+
+    const double firstTimestamp = file.Record(0).Timestamp;
+    const ros::WallTime start = ros::WallTime::now();
+    for (size_t index = 0;
+         (index < numberOfRecords) && ros::ok();
+         ++index) {
+        const dvrk::state_record & record = file.Record(index);
+        if (record.NumberOfJoints > dvrk::state_record_maximum_joints) {
+            std::cerr << "Error: invalid number of joints (" << record.NumberOfJoints
+                      << ") in record " << index << ", maximum is " << dvrk::state_record_maximum_joints << std::endl;
+            return -1;
+        }
+        const ros::WallTime due = start + ros::WallDuration((record.Timestamp - firstTimestamp) / speed);
+        const ros::WallDuration wait = due - ros::WallTime::now();
+        if (wait > ros::WallDuration(0.0)) {
+            wait.sleep();
+        }
+        const ros::Time now = ros::Time::now();
+        sensor_msgs::JointState::Ptr jointState(new sensor_msgs::JointState);
+        jointState->header.stamp = now;
+        dvrk::record_to_joint_state(record.MeasuredPosition, record.MeasuredVelocity, record.MeasuredEffort,
+                                    record.NumberOfJoints, *jointState);
+        measuredJS.publish(jointState);
+        jointState.reset(new sensor_msgs::JointState);
+        jointState->header.stamp = now;
+        dvrk::record_to_joint_state(record.SetpointPosition, 0, record.SetpointEffort,
+                                    record.NumberOfJoints, *jointState);
+        setpointJS.publish(jointState);
+        geometry_msgs::PoseStamped::Ptr pose(new geometry_msgs::PoseStamped);
+        pose->header.stamp = now;
+        dvrk::record_to_pose(record.MeasuredCP, pose->pose);
+        measuredCP.publish(pose);
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-29
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnUnits.h>
+
+#include <dvrk_utilities/dvrk_tf_publisher.h>
+
+dvrk::tf_publisher::tf_publisher(const dvrk_topics_rate::rate rate):
+    publisher_base("/tf", rate, 100),
+    mStaticDeadband(0.1 * cmn_mm)
+{
+}
+
+void dvrk::tf_publisher::Advertise(ros::NodeHandle & node_handle)
+{
+    mPublisher = node_handle.advertise<tf2_msgs::TFMessage>(mTopicName, mQueueSize);
+    // latched, new listeners get all the static frames
+    mStaticPublisher = node_handle.advertise<tf2_msgs::TFMessage>("/tf_static", 1, true);
+}
+
+void dvrk::tf_publisher::AddFrame(command_read_source<prmPositionCartesianGet> * source,
+                                  const bool is_static)
+{
+    frame newFrame;
+    newFrame.Source = source;
+    newFrame.Static = is_static;
+    newFrame.First = true;
+    mFrames.push_back(newFrame);
+}
+
+bool dvrk::tf_publisher::Execute(void)
+{
+    bool result = true;
+    bool staticChanged = false;
+    // dynamic frames are skipped if no one listens, static frames are
+    // always updated since new listeners get the latched message
+    const bool dynamic = !mLazy || (mPublisher.getNumSubscribers() > 0);
+    tf2_msgs::TFMessage::Ptr message(new tf2_msgs::TFMessage);
+    message->transforms.reserve(mFrames.size());
+
+    const FramesType::iterator end = mFrames.end();
+    FramesType::iterator frame;
+    for (frame = mFrames.begin(); frame != end; ++frame) {
+        if (!frame->Static && !dynamic) {
+            continue;
+        }
+        if (!frame->Source->Read()) {
+            result = false;
+            continue;
+        }
+        const prmPositionCartesianGet & cisstData = frame->Source->Data();
+        if (!dvrk::sample_valid(cisstData)) {
+            continue;
+        }
+        if (!frame->First) {
+            if (frame->Static) {
+                if (dvrk::sample_distance(cisstData, frame->LastPublished) <= mStaticDeadband) {
+                    continue;
+                }
+            } else {
+                const double timestamp = dvrk::sample_timestamp(cisstData);
+                if ((timestamp != 0.0)
+                    && (timestamp == dvrk::sample_timestamp(frame->LastPublished))) {
+                    continue;
+                }
+            }
+        }
+        if (!mtsCISSTToROS(cisstData, frame->Transform, mTopicName)
+            || frame->Transform.header.frame_id.empty()
+            || frame->Transform.child_frame_id.empty()) {
+            result = false;
+            continue;
+        }
+        frame->LastPublished = cisstData;
+        frame->First = false;
+        if (frame->Static) {
+            staticChanged = true;
+        } else {
+            message->transforms.push_back(frame->Transform);
+            RecordLatency(dvrk::sample_timestamp(cisstData));
+        }
+    }
+
+    if (!message->transforms.empty()) {
+        mPublisher.publish(message);
+    }
+
+    if (staticChanged) {
+        tf2_msgs::TFMessage::Ptr staticMessage(new tf2_msgs::TFMessage);
+        for (frame = mFrames.begin(); frame != end; ++frame) {
+            if (frame->Static && !frame->First) {
+                staticMessage->transforms.push_back(frame->Transform);
+            }
+        }
+        mStaticPublisher.publish(staticMessage);
+    }
+    return result;
+}
@@ -0,0 +1,120 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-06-04
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaSleep.h>
+
+#include <dvrk_utilities/dvrk_thread_configurator.h>
+
+dvrk::thread_configurator::task::task(void):
+    Apply(true),
+    Applied(false),
+    Done(false)
+{
+}
+
+void dvrk::thread_configurator::task::RunEventHandler(void)
+{
+    if (Done.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (Apply) {
+        Applied = apply_thread_settings(Settings, Message);
+    } else {
+        Applied = true;
+    }
+    Effective = current_thread_settings();
+    // Report only reads the results once Done is set
+    Done.store(true, std::memory_order_release);
+}
+
+dvrk::thread_configurator::thread_configurator(const std::string & component_name):
+    mtsComponent(component_name)
+{
+}
+
+dvrk::thread_configurator::~thread_configurator()
+{
+    const TasksType::iterator end = mTasks.end();
+    TasksType::iterator iter;
+    for (iter = mTasks.begin();
+         iter != end;
+         ++iter) {
+        delete *iter;
+    }
+    mTasks.clear();
+}
+
+bool dvrk::thread_configurator::AddTask(const std::string & task_name,
+                                        const thread_settings & settings,
+                                        const bool apply)
+{
+    mtsInterfaceRequired * interfaceRequired = AddInterfaceRequired(task_name + "-run");
+    if (!interfaceRequired) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddTask: failed to create required interface for \""
+                                 << task_name << "\"" << std::endl;
+        return false;
+    }
+    task * newTask = new task;
+    newTask->Name = task_name;
+    newTask->Settings = settings;
+    newTask->Apply = apply;
+    if (!interfaceRequired->AddEventHandlerVoid(&task::RunEventHandler, newTask,
+                                                "RunEvent", MTS_EVENT_NOT_QUEUED)) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddTask: failed to add event handler for \""
+                                 << task_name << "\"" << std::endl;
+        delete newTask;
+        return false;
+    }
+    mTasks.push_back(newTask);
+    return true;
+}
+
+bool dvrk::thread_configurator::Report(std::ostream & output_stream,
+                                       const double & timeout_in_seconds) const
+{
+    bool result = true;
+    const double end = osaGetTime() + timeout_in_seconds;
+    const TasksType::const_iterator tasksEnd = mTasks.end();
+    TasksType::const_iterator iter;
+    for (iter = mTasks.begin();
+         iter != tasksEnd;
+         ++iter) {
+        const task * current = *iter;
+        while (!current->Done.load(std::memory_order_acquire)
+               && (osaGetTime() < end)) {
+            osaSleep(1.0 * cmn_ms);
+        }
+        output_stream << current->Name << std::endl;
+        if (current->Apply) {
+            output_stream << " - requested: " << current->Settings.HumanReadable() << std::endl;
+        }
+        if (!current->Done.load(std::memory_order_acquire)) {
+            output_stream << " - effective: unknown, task hasn't run yet" << std::endl;
+            continue;
+        }
+        if (!current->Applied) {
+            output_stream << " - error: " << current->Message << std::endl;
+            CMN_LOG_CLASS_INIT_ERROR << "Report: " << current->Name
+                                     << ", " << current->Message << std::endl;
+            result = false;
+        }
+        output_stream << " - effective: " << current->Effective << std::endl;
+    }
+    return result;
+}
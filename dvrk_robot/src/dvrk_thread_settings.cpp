@@ -0,0 +1,306 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-08
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <dvrk_utilities/dvrk_thread_settings.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include <cisstCommon/cmnPortability.h>
+
+#if (CISST_OS == CISST_LINUX)
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+#include <json/json.h>
+
+namespace {
+    // integer from a string, returns false if the whole string is not
+    // an integer
+    bool int_from_string(const std::string & value, int & result)
+    {
+        if (value.empty()) {
+            return false;
+        }
+        char * end;
+        const long converted = strtol(value.c_str(), &end, 10);
+        if (*end != '\0') {
+            return false;
+        }
+        result = static_cast<int>(converted);
+        return true;
+    }
+
+    // CPU index usable with CPU_SET, larger values would write past
+    // the end of cpu_set_t
+    bool valid_cpu(const int cpu)
+    {
+#if (CISST_OS == CISST_LINUX)
+        return (cpu >= 0) && (cpu < CPU_SETSIZE);
+#else
+        return (cpu >= 0);
+#endif
+    }
+
+    bool valid_cpu(const Json::Value & cpu)
+    {
+        return cpu.isInt() && valid_cpu(cpu.asInt());
+    }
+}
+
+bool dvrk::thread_settings::IsDefault(void) const
+{
+    return CPUs.empty()
+        && (Policy == POLICY_UNCHANGED)
+        && (Priority <= 0)
+        && !SetNice;
+}
+
+bool dvrk::thread_settings::FromJSON(const Json::Value & json_value)
+{
+    if (!json_value.isObject()) {
+        return false;
+    }
+    const Json::Value cpus = json_value["cpus"];
+    if (cpus.isArray()) {
+        CPUs.clear();
+        for (unsigned int index = 0; index < cpus.size(); ++index) {
+            if (!valid_cpu(cpus[index])) {
+                return false;
+            }
+            CPUs.push_back(cpus[index].asInt());
+        }
+    } else if (cpus.isInt()) {
+        if (!valid_cpu(cpus)) {
+            return false;
+        }
+        CPUs.clear();
+        CPUs.push_back(cpus.asInt());
+    } else if (!cpus.empty()) {
+        return false;
+    }
+    const Json::Value policy = json_value["policy"];
+    if (!policy.empty()) {
+        const std::string name = policy.asString();
+        if (name == "fifo") {
+            Policy = POLICY_FIFO;
+        } else if (name == "other") {
+            Policy = POLICY_OTHER;
+        } else {
+            return false;
+        }
+    }
+    const Json::Value priority = json_value["priority"];
+    if (!priority.empty()) {
+        Priority = priority.asInt();
+    }
+    const Json::Value nice = json_value["nice"];
+    if (!nice.empty()) {
+        SetNice = true;
+        Nice = nice.asInt();
+    }
+    return (Policy != POLICY_FIFO) || (Priority > 0);
+}
+
+bool dvrk::thread_settings::FromString(const std::string & settings)
+{
+    // cpus after @
+    std::string policyAndValue = settings;
+    const size_t at = settings.find('@');
+    if (at != std::string::npos) {
+        policyAndValue = settings.substr(0, at);
+        std::stringstream cpus(settings.substr(at + 1));
+        std::string cpu;
+        CPUs.clear();
+        while (std::getline(cpus, cpu, ',')) {
+            int index;
+            if (!int_from_string(cpu, index) || !valid_cpu(index)) {
+                return false;
+            }
+            CPUs.push_back(index);
+        }
+        if (CPUs.empty()) {
+            return false;
+        }
+    }
+    if (policyAndValue.empty()) {
+        return true;
+    }
+    // policy and optional value after :
+    std::string value;
+    const size_t colon = policyAndValue.find(':');
+    if (colon != std::string::npos) {
+        value = policyAndValue.substr(colon + 1);
+        policyAndValue = policyAndValue.substr(0, colon);
+    }
+    if (policyAndValue == "fifo") {
+        Policy = POLICY_FIFO;
+        if (!value.empty() && !int_from_string(value, Priority)) {
+            return false;
+        }
+        return (Priority > 0);
+    }
+    if (policyAndValue == "other") {
+        Policy = POLICY_OTHER;
+        if (!value.empty()) {
+            SetNice = int_from_string(value, Nice);
+            return SetNice;
+        }
+        return true;
+    }
+    return false;
+}
+
+std::string dvrk::thread_settings::HumanReadable(void) const
+{
+    std::stringstream result;
+    result << "cpus: ";
+    if (CPUs.empty()) {
+        result << "all";
+    } else {
+        for (size_t index = 0; index < CPUs.size(); ++index) {
+            result << (index ? ", " : "") << CPUs[index];
+        }
+    }
+    switch (Policy) {
+    case POLICY_FIFO:
+        result << ", policy: fifo";
+        break;
+    case POLICY_OTHER:
+        result << ", policy: other";
+        break;
+    default:
+        break;
+    }
+    result << ", priority: " << Priority;
+    if (SetNice) {
+        result << ", nice: " << Nice;
+    }
+    return result.str();
+}
+
+bool dvrk::apply_thread_settings(const thread_settings & settings,
+                                 std::string & message)
+{
+    bool result = true;
+    message.clear();
+#if (CISST_OS == CISST_LINUX)
+    if (!settings.CPUs.empty()) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (size_t index = 0; index < settings.CPUs.size(); ++index) {
+            CPU_SET(settings.CPUs[index], &cpuSet);
+        }
+        const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+        if (error != 0) {
+            message += std::string("failed to set CPU affinity: ") + strerror(error) + "; ";
+            result = false;
+        }
+    }
+    const bool fifo = (settings.Policy == thread_settings::POLICY_FIFO)
+        || ((settings.Policy == thread_settings::POLICY_UNCHANGED) && (settings.Priority > 0));
+    if (fifo || (settings.Policy == thread_settings::POLICY_OTHER)) {
+        sched_param parameters;
+        parameters.sched_priority = fifo ? settings.Priority : 0;
+        const int error = pthread_setschedparam(pthread_self(), fifo ? SCHED_FIFO : SCHED_OTHER, &parameters);
+        if (error != 0) {
+            message += std::string("failed to set policy and priority: ") + strerror(error) + "; ";
+            result = false;
+        }
+    }
+    // on Linux, nice is per thread when using the thread id
+    if (settings.SetNice
+        && (setpriority(PRIO_PROCESS, syscall(SYS_gettid), settings.Nice) != 0)) {
+        message += std::string("failed to set nice value: ") + strerror(errno) + "; ";
+        result = false;
+    }
+#else
+    if (!settings.IsDefault()) {
+        message = "thread settings are only supported on Linux";
+        result = false;
+    }
+#endif
+    return result;
+}
+
+std::string dvrk::current_thread_settings(void)
+{
+    std::stringstream result;
+#if (CISST_OS == CISST_LINUX)
+    int policy;
+    sched_param parameters;
+    if (pthread_getschedparam(pthread_self(), &policy, &parameters) == 0) {
+        switch (policy) {
+        case SCHED_FIFO:
+            result << "policy: fifo";
+            break;
+        case SCHED_RR:
+            result << "policy: rr";
+            break;
+        case SCHED_OTHER:
+            result << "policy: other";
+            break;
+        default:
+            result << "policy: " << policy;
+            break;
+        }
+        result << ", priority: " << parameters.sched_priority;
+    }
+    errno = 0;
+    const int nice = getpriority(PRIO_PROCESS, syscall(SYS_gettid));
+    if (errno == 0) {
+        result << ", nice: " << nice;
+    }
+    cpu_set_t cpuSet;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0) {
+        result << ", cpus: ";
+        bool first = true;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &cpuSet)) {
+                result << (first ? "" : ", ") << cpu;
+                first = false;
+            }
+        }
+    }
+#else
+    result << "not available";
+#endif
+    return result.str();
+}
+
+bool dvrk::lock_memory(std::string & message)
+{
+    message.clear();
+#if (CISST_OS == CISST_LINUX)
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        message = std::string("failed to lock memory: ") + strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    message = "memory locking is only supported on Linux";
+    return false;
+#endif
+}
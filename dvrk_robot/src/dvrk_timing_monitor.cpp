@@ -0,0 +1,289 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-06-03
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <sched.h>
+
+#include <cisstMultiTask/mtsManagerLocal.h>
+
+#include <dvrk_utilities/dvrk_timing_monitor.h>
+
+#include <diagnostic_msgs/DiagnosticArray.h>
+
+dvrk::timing_monitor::task::task(void):
+    NominalPeriod(0.0),
+    OverrunThreshold(0.0),
+    Last(0.0),
+    Active(0),
+    Writing(false),
+    TotalCount(0),
+    TotalOverruns(0),
+    MaxEver(0.0),
+    LogOverruns(0)
+{
+    Overruns[0] = 0;
+    Overruns[1] = 0;
+}
+
+void dvrk::timing_monitor::task::RunEventHandler(void)
+{
+    const double now = mtsManagerLocal::GetInstance()->GetTimeServer().GetRelativeTime();
+    if (Last > 0.0) {
+        const double interval = now - Last;
+        const bool overrun = (OverrunThreshold > 0.0) && (interval > OverrunThreshold);
+        // Writing is set before reading the active buffer so Collect
+        // can wait for this run if it swaps the buffers meanwhile
+        Writing.store(true);
+        const int index = Active.load();
+        Intervals[index].Add(interval);
+        if (overrun) {
+            ++Overruns[index];
+        }
+        Writing.store(false);
+        ++TotalCount;
+        if (overrun) {
+            ++TotalOverruns;
+        }
+        // only this thread writes MaxEver
+        if (interval > MaxEver.load(std::memory_order_relaxed)) {
+            MaxEver.store(interval, std::memory_order_relaxed);
+        }
+    }
+    Last = now;
+}
+
+void dvrk::timing_monitor::task::Collect(statistics & result)
+{
+    const int index = Active.load();
+    Active.store(1 - index);
+    // wait for a run started before the swap, short since the
+    // handler doesn't block
+    while (Writing.load()) {
+        sched_yield();
+    }
+    latency_histogram & intervals = Intervals[index];
+    result.Name = Name;
+    result.NominalPeriod = NominalPeriod;
+    result.Count = intervals.Count();
+    result.P50 = intervals.Percentile(0.5);
+    result.P99 = intervals.Percentile(0.99);
+    result.P999 = intervals.Percentile(0.999);
+    result.Max = intervals.Max();
+    result.Overruns = Overruns[index];
+    result.TotalCount = TotalCount.load();
+    result.TotalOverruns = TotalOverruns.load();
+    result.MaxEver = MaxEver.load();
+    LogIntervals.Merge(intervals);
+    LogOverruns += Overruns[index];
+    intervals.Reset();
+    Overruns[index] = 0;
+}
+
+dvrk::timing_monitor::timing_monitor(const std::string & component_name):
+    mtsComponent(component_name),
+    mOverrunRatio(1.2),
+    mLogPeriod(10.0),
+    mNextLog(0.0)
+{
+}
+
+dvrk::timing_monitor::~timing_monitor()
+{
+    const TasksType::iterator end = mTasks.end();
+    TasksType::iterator iter;
+    for (iter = mTasks.begin();
+         iter != end;
+         ++iter) {
+        delete *iter;
+    }
+    mTasks.clear();
+}
+
+bool dvrk::timing_monitor::AddTask(const std::string & task_name,
+                                   const double & nominal_period_in_seconds)
+{
+    mtsInterfaceRequired * interfaceRequired = AddInterfaceRequired(task_name + "-run");
+    if (!interfaceRequired) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddTask: failed to create required interface for \""
+                                 << task_name << "\"" << std::endl;
+        return false;
+    }
+    task * newTask = new task;
+    newTask->Name = task_name;
+    newTask->NominalPeriod = nominal_period_in_seconds;
+    newTask->OverrunThreshold = mOverrunRatio * nominal_period_in_seconds;
+    if (!interfaceRequired->AddEventHandlerVoid(&task::RunEventHandler, newTask,
+                                                "RunEvent", MTS_EVENT_NOT_QUEUED)) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddTask: failed to add event handler for \""
+                                 << task_name << "\"" << std::endl;
+        delete newTask;
+        return false;
+    }
+    mTasks.push_back(newTask);
+    return true;
+}
+
+void dvrk::timing_monitor::SetOverrunRatio(const double & ratio)
+{
+    mOverrunRatio = ratio;
+    const TasksType::iterator end = mTasks.end();
+    TasksType::iterator iter;
+    for (iter = mTasks.begin();
+         iter != end;
+         ++iter) {
+        (*iter)->OverrunThreshold = ratio * (*iter)->NominalPeriod;
+    }
+}
+
+void dvrk::timing_monitor::Collect(std::vector<statistics> & result)
+{
+    result.resize(mTasks.size());
+    std::vector<statistics>::iterator statistics = result.begin();
+    const TasksType::iterator end = mTasks.end();
+    TasksType::iterator iter;
+    for (iter = mTasks.begin();
+         iter != end;
+         ++iter, ++statistics) {
+        (*iter)->Collect(*statistics);
+    }
+
+    if (mLogPeriod <= 0.0) {
+        return;
+    }
+    const double now = mtsManagerLocal::GetInstance()->GetTimeServer().GetRelativeTime();
+    if (mNextLog == 0.0) {
+        mNextLog = now + mLogPeriod;
+    } else if (now >= mNextLog) {
+        mNextLog = now + mLogPeriod;
+        Log();
+    }
+}
+
+void dvrk::timing_monitor::Log(void)
+{
+    std::stringstream summary;
+    bool overrun = false;
+    summary << "timing summary (ms, p50/p99/p99.9/max, overruns/runs, total overruns/runs)";
+    const TasksType::iterator end = mTasks.end();
+    TasksType::iterator iter;
+    for (iter = mTasks.begin();
+         iter != end;
+         ++iter) {
+        task * current = *iter;
+        summary << std::endl << "  " << current->Name
+                << " [" << current->NominalPeriod * 1000.0 << "]: "
+                << current->LogIntervals.Percentile(0.5) * 1000.0 << "/"
+                << current->LogIntervals.Percentile(0.99) * 1000.0 << "/"
+                << current->LogIntervals.Percentile(0.999) * 1000.0 << "/"
+                << current->LogIntervals.Max() * 1000.0 << ", "
+                << current->LogOverruns << "/" << current->LogIntervals.Count() << ", "
+                << current->TotalOverruns.load() << "/" << current->TotalCount.load();
+        if (current->LogOverruns > 0) {
+            overrun = true;
+        }
+        current->LogIntervals.Reset();
+        current->LogOverruns = 0;
+    }
+    if (overrun) {
+        CMN_LOG_CLASS_RUN_WARNING << "Log: " << summary.str() << std::endl;
+    } else {
+        CMN_LOG_CLASS_RUN_VERBOSE << "Log: " << summary.str() << std::endl;
+    }
+}
+
+dvrk::timing_statistics_publisher::timing_statistics_publisher(timing_monitor * monitor,
+                                                               const std::string & topic_name,
+                                                               const double & period_in_seconds):
+    publisher_base(topic_name, dvrk_topics_rate::slow),
+    mMonitor(monitor),
+    mPeriod(period_in_seconds),
+    mNext(0.0)
+{
+}
+
+void dvrk::timing_statistics_publisher::Advertise(ros::NodeHandle & node_handle)
+{
+    mPublisher = node_handle.advertise<diagnostic_msgs::DiagnosticArray>(mTopicName, mQueueSize);
+}
+
+bool dvrk::timing_statistics_publisher::Execute(void)
+{
+    const double now = mtsManagerLocal::GetInstance()->GetTimeServer().GetRelativeTime();
+    if (now < mNext) {
+        return true;
+    }
+    mNext = now + mPeriod;
+
+    // always collect, the monitor also logs a summary
+    mMonitor->Collect(mStatistics);
+    if (mLazy && (mPublisher.getNumSubscribers() == 0)) {
+        return true;
+    }
+
+    diagnostic_msgs::DiagnosticArray::Ptr rosData(new diagnostic_msgs::DiagnosticArray);
+    rosData->status.reserve(mStatistics.size());
+    const std::vector<timing_monitor::statistics>::const_iterator end = mStatistics.end();
+    std::vector<timing_monitor::statistics>::const_iterator statistics;
+    for (statistics = mStatistics.begin();
+         statistics != end;
+         ++statistics) {
+        diagnostic_msgs::DiagnosticStatus status;
+        if (statistics->Overruns > 0) {
+            status.level = diagnostic_msgs::DiagnosticStatus::WARN;
+            status.message = std::to_string(statistics->Overruns) + " overrun(s)";
+        } else {
+            status.level = diagnostic_msgs::DiagnosticStatus::OK;
+            status.message = "period (ms)";
+        }
+        status.name = statistics->Name;
+        diagnostic_msgs::KeyValue value;
+        value.key = "nominal";
+        value.value = std::to_string(statistics->NominalPeriod * 1000.0);
+        status.values.push_back(value);
+        value.key = "count";
+        value.value = std::to_string(statistics->Count);
+        status.values.push_back(value);
+        value.key = "p50";
+        value.value = std::to_string(statistics->P50 * 1000.0);
+        status.values.push_back(value);
+        value.key = "p99";
+        value.value = std::to_string(statistics->P99 * 1000.0);
+        status.values.push_back(value);
+        value.key = "p99.9";
+        value.value = std::to_string(statistics->P999 * 1000.0);
+        status.values.push_back(value);
+        value.key = "max";
+        value.value = std::to_string(statistics->Max * 1000.0);
+        status.values.push_back(value);
+        value.key = "overruns";
+        value.value = std::to_string(statistics->Overruns);
+        status.values.push_back(value);
+        value.key = "total_count";
+        value.value = std::to_string(statistics->TotalCount);
+        status.values.push_back(value);
+        value.key = "total_overruns";
+        value.value = std::to_string(statistics->TotalOverruns);
+        status.values.push_back(value);
+        value.key = "max_ever";
+        value.value = std::to_string(statistics->MaxEver * 1000.0);
+        status.values.push_back(value);
+        rosData->status.push_back(status);
+    }
+    rosData->header.stamp = ros::Time::now();
+    mPublisher.publish(rosData);
+    return true;
+}
@@ -0,0 +1,77 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Author(s):  Anton Deguet
+  Created on: 2019-05-20
+
+  (C) Copyright 2019 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <dvrk_utilities/dvrk_topics_registry.h>
+
+bool dvrk::add_topics_from_table(dvrk::bridge & bridge,
+                                 const std::string & ros_namespace,
+                                 const std::string & component_name,
+                                 const topics_versions & versions,
+                                 const topic_entry * table,
+                                 const size_t size)
+{
+    bool result = true;
+    const topics_versions::const_iterator end = versions.end();
+    for (size_t index = 0; index < size; ++index) {
+        const topic_entry & entry = table[index];
+        topics_versions::const_iterator version;
+        for (version = versions.begin();
+             version != end;
+             ++version) {
+            const topic_version & variant = entry.Versions[*version];
+            if (!variant.Topic) {
+                continue;
+            }
+            // check if a previous version already added the same topic
+            bool skip = false;
+            topics_versions::const_iterator previous;
+            for (previous = versions.begin();
+                 (previous != version) && !skip;
+                 ++previous) {
+                const topic_version & previousVariant = entry.Versions[*previous];
+                if (previousVariant.Topic
+                    && (std::string(previousVariant.Topic) == variant.Topic)) {
+                    skip = true;
+                    if (previousVariant.Add != variant.Add) {
+                        CMN_LOG_INIT_WARNING << "add_topics_from_table: topic \""
+                                             << ros_namespace << variant.Topic
+                                             << "\" has a different type in version "
+                                             << dvrk_topics_version::versionToString(*version)
+                                             << ", using version "
+                                             << dvrk_topics_version::versionToString(*previous)
+                                             << std::endl;
+                    }
+                }
+            }
+            if (skip) {
+                continue;
+            }
+            if (!variant.Add(bridge,
+                             component_name + entry.Interface,
+                             entry.Command,
+                             ros_namespace + variant.Topic,
+                             entry.Rate)) {
+                CMN_LOG_INIT_ERROR << "add_topics_from_table: failed to add topic \""
+                                   << ros_namespace << variant.Topic << "\" for command \""
+                                   << entry.Command << "\"" << std::endl;
+                result = false;
+            }
+        }
+    }
+    return result;
+}